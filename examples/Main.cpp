@@ -2,7 +2,9 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include "Kedarium/AssetLoader.hpp"
 #include "Kedarium/Core.hpp"
 #include "Kedarium/Color.hpp"
 #include "Kedarium/Keys.hpp"
@@ -10,6 +12,7 @@
 #include "Kedarium/Window.hpp"
 #include "Kedarium/Camera.hpp"
 #include "Kedarium/Debug.hpp"
+#include "Kedarium/Space.hpp"
 
 // Constants
 constexpr unsigned int WINDOW_WIDTH  {800};
@@ -24,6 +27,12 @@ constexpr float CAMERA_FAR         {100.f};
 constexpr float CAMERA_SPEED       {0.1f};
 constexpr float CAMERA_SENSITIVITY {100.f};
 
+// Instance Settings
+constexpr int   INSTANCE_COLUMNS {400};
+constexpr int   INSTANCE_ROWS    {250};
+constexpr int   INSTANCE_COUNT   {INSTANCE_COLUMNS * INSTANCE_ROWS};
+constexpr float INSTANCE_SPACING {1.25f};
+
 // Vertices and Indices
 GLfloat vertices[] = {
   -0.5f, -0.5f, 0.f, 1.f, 1.f, 1.f, 0.f, 0.f,
@@ -43,8 +52,12 @@ class MainWindow : public kdr::Window
 
     ~MainWindow()
     {
-      this->defaultShader.Delete();
-      this->concreteTexture.Delete();
+      const kdr::gfx::StateCacheStats& stateStats = kdr::gfx::getStateCache().getStats();
+      std::cout << "State cache: " << stateStats.issued << " calls issued, ";
+      std::cout << stateStats.elided << " redundant calls elided\n";
+
+      this->assetLoader.Delete();
+      this->instanceBuffer.Delete();
 
       this->VAO1.Delete();
       this->VBO1.Delete();
@@ -58,7 +71,18 @@ class MainWindow : public kdr::Window
       std::cout << '\n';
       kdr::core::printVersionInfo();
 
-      this->concreteTexture.TextureUnit(this->defaultShader.getID(), "tex0", 0);
+      // Assets load on the worker threads while the geometry is built below
+      this->assetLoader.setProgressCallback([](size_t completedCount, size_t requestedCount) {
+        std::cout << "Loaded " << completedCount << '/' << requestedCount << " assets\n";
+      });
+      this->defaultShader = this->assetLoader.LoadShader(
+        "resources/Shaders/instanced.vert",
+        "resources/Shaders/default.frag"
+      );
+      this->concreteTexture = this->assetLoader.LoadTexture(
+        "resources/Textures/concrete.png",
+        {GL_LINEAR_MIPMAP_LINEAR, GL_NEAREST, GL_REPEAT, GL_REPEAT, 8.f}
+      );
 
       this->VAO1.Bind();
       this->VBO1.Bind();
@@ -68,9 +92,36 @@ class MainWindow : public kdr::Window
       this->VAO1.LinkAttribute(this->VBO1, 1, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
       this->VAO1.LinkAttribute(this->VBO1, 2, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
 
+      std::vector<kdr::space::Mat4> models;
+      models.reserve(INSTANCE_COUNT);
+      for (int row = 0; row < INSTANCE_ROWS; row++)
+      {
+        for (int column = 0; column < INSTANCE_COLUMNS; column++)
+        {
+          const kdr::space::Vec3 offset {column * INSTANCE_SPACING, row * INSTANCE_SPACING, 0.f};
+          models.push_back(kdr::space::translate(kdr::space::Mat4 {1.f}, offset));
+        }
+      }
+      this->instanceBuffer.Update(models.data(), models.size() * sizeof(kdr::space::Mat4));
+      this->VAO1.LinkMatrixAttribute(this->instanceBuffer, 3, sizeof(kdr::space::Mat4), (void*)0);
+
       this->VAO1.Unbind();
       this->VBO1.Unbind();
       this->EBO1.Unbind();
+
+      while (!this->assetLoader.isDone())
+      {
+        this->assetLoader.Update();
+      }
+      std::cout << "Program cache: " << this->programCache.getStats().hits << " hits, ";
+      std::cout << this->programCache.getStats().misses << " misses\n";
+
+      kdr::gfx::Shader*  shader  = this->assetLoader.getShader(this->defaultShader);
+      kdr::gfx::Texture* texture = this->assetLoader.getTexture(this->concreteTexture);
+      if (shader != NULL && texture != NULL)
+      {
+        texture->TextureUnit(*shader, "tex0", 0);
+      }
     }
 
     void update()
@@ -113,27 +164,30 @@ class MainWindow : public kdr::Window
 
     void render()
     {
-      this->bindShader(this->defaultShader);
-      this->VAO1.Bind();
-      this->concreteTexture.Bind();
-      glDrawElements(GL_TRIANGLES, sizeof(indices) / sizeof(GLuint), GL_UNSIGNED_INT, NULL);
+      kdr::gfx::Shader*  shader  = this->assetLoader.getShader(this->defaultShader);
+      kdr::gfx::Texture* texture = this->assetLoader.getTexture(this->concreteTexture);
+      if (shader == NULL || texture == NULL) return;
+
+      this->bindShader(*shader);
+
+      kdr::gfx::DrawCommand quads;
+      quads.shaderID      = shader->getID();
+      quads.vaoID         = this->VAO1.getID();
+      quads.textureID     = texture->getID();
+      quads.count         = sizeof(indices) / sizeof(GLuint);
+      quads.instanceCount = INSTANCE_COUNT;
+      this->getRenderQueue().Submit(kdr::gfx::RenderPass::Opaque, quads, 0.f);
     }
 
   private:
-    kdr::gfx::Shader defaultShader {
-      "resources/Shaders/default.vert",
-      "resources/Shaders/default.frag"
-    };
-    kdr::gfx::Texture concreteTexture {
-      "resources/Textures/concrete.png",
-      GL_TEXTURE_2D,
-      GL_TEXTURE0,
-      GL_RGBA,
-      GL_UNSIGNED_BYTE
-    };
+    kdr::gfx::ProgramCache        programCache    {"cache/programs"};
+    kdr::gfx::AssetLoader         assetLoader     {0, &this->programCache};
+    kdr::gfx::AssetLoader::Handle defaultShader   {0};
+    kdr::gfx::AssetLoader::Handle concreteTexture {0};
     kdr::gfx::VAO VAO1;
     kdr::gfx::VBO VBO1 {vertices, sizeof(vertices)};
     kdr::gfx::EBO EBO1 {indices, sizeof(indices)};
+    kdr::gfx::InstanceBuffer instanceBuffer {INSTANCE_COUNT * sizeof(kdr::space::Mat4)};
 
     bool pressingFullscreen {false};
 };
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Kedarium/Pixel.hpp"
+#include "Kedarium/Simd.hpp"
+
+// Settings
+constexpr int    IMAGE_SIZE  {2048};
+constexpr int    RUN_COUNT   {20};
+constexpr size_t PIXEL_COUNT {(size_t)IMAGE_SIZE * IMAGE_SIZE};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Runs a kernel RUN_COUNT times and prints its throughput over the bytes it reads and writes.
+ */
+void measure(const char* name, const size_t bytes, const std::function<void()>& kernel)
+{
+  kernel();
+  const Clock::time_point start = Clock::now();
+  for (int run = 0; run < RUN_COUNT; run++)
+  {
+    kernel();
+  }
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count() / RUN_COUNT;
+  std::cout << "  " << name << (bytes / seconds) / 1e9 << " GB/s\n";
+}
+
+int main()
+{
+  std::mt19937 rng {42};
+  std::vector<uint8_t> rgb(PIXEL_COUNT * 3);
+  std::vector<uint8_t> rgba(PIXEL_COUNT * 4);
+  std::vector<float>   linear(PIXEL_COUNT * 4);
+  std::vector<uint8_t> output(PIXEL_COUNT * 4);
+  std::vector<float>   floatOutput(PIXEL_COUNT * 4);
+  for (uint8_t& value : rgb) value = rng();
+  for (uint8_t& value : rgba) value = rng();
+  // Slightly out of range, as filtered values can be
+  std::uniform_real_distribution<float> unit {-0.05f, 1.05f};
+  for (float& value : linear) value = unit(rng);
+
+  std::cout << "Pixel kernels (" << kdr::simd::getInstructionSet() << ") over " << IMAGE_SIZE << "x" << IMAGE_SIZE << " pixels:\n";
+
+  measure("RGB to RGBA:          ", PIXEL_COUNT * 7, [&]() {
+    kdr::img::expandRGBToRGBA(rgb.data(), output.data(), PIXEL_COUNT);
+  });
+  measure("RGBA to BGRA:         ", PIXEL_COUNT * 8, [&]() {
+    kdr::img::swapRedBlue(rgba.data(), output.data(), PIXEL_COUNT);
+  });
+  measure("Premultiply alpha:    ", PIXEL_COUNT * 8, [&]() {
+    kdr::img::premultiplyAlpha(rgba.data(), output.data(), PIXEL_COUNT);
+  });
+
+  for (const bool isSRGB : {false, true})
+  {
+    measure(isSRGB ? "sRGB to linear float: " : "Unorm8 to float:      ", PIXEL_COUNT * 20, [&]() {
+      kdr::img::decodePixels(rgba.data(), floatOutput.data(), PIXEL_COUNT, isSRGB);
+    });
+    measure(isSRGB ? "Linear float to sRGB: " : "Float to unorm8:      ", PIXEL_COUNT * 20, [&]() {
+      kdr::img::encodePixels(linear.data(), output.data(), PIXEL_COUNT, isSRGB);
+    });
+  }
+
+  output = rgba;
+  measure("Vertical flip:        ", PIXEL_COUNT * 8, [&]() {
+    kdr::img::flipRows(output.data(), (size_t)IMAGE_SIZE * 4, IMAGE_SIZE);
+  });
+
+  return 0;
+}
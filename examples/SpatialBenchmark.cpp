@@ -0,0 +1,139 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Kedarium/Space.hpp"
+#include "Kedarium/Culling.hpp"
+#include "Kedarium/Spatial.hpp"
+
+// Settings
+constexpr int   OBJECT_COUNT {50000};
+constexpr int   FRAME_COUNT  {100};
+constexpr float WORLD_SIZE   {1000.f};
+constexpr float MAX_SPEED    {0.5f};
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool overlapsBox(const kdr::space::AABB& boxA, const kdr::space::AABB& boxB)
+{
+  return
+    boxA.min.x <= boxB.max.x && boxA.min.y <= boxB.max.y && boxA.min.z <= boxB.max.z &&
+    boxA.max.x >= boxB.min.x && boxA.max.y >= boxB.min.y && boxA.max.z >= boxB.min.z;
+}
+
+int main()
+{
+  std::mt19937 rng {42};
+  std::uniform_real_distribution<float> position {-WORLD_SIZE / 2.f, WORLD_SIZE / 2.f};
+  std::uniform_real_distribution<float> size     {0.5f, 4.f};
+  std::uniform_real_distribution<float> speed    {-MAX_SPEED, MAX_SPEED};
+
+  std::vector<kdr::space::AABB> boxes;
+  std::vector<kdr::space::Vec3> velocities;
+  std::vector<int>              proxies;
+  kdr::space::DynamicBVH        bvh {2.f};
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < OBJECT_COUNT; i++)
+  {
+    const kdr::space::Vec3 center {position(rng), position(rng), position(rng)};
+    const float extent = size(rng);
+    boxes.push_back({center - extent, center + extent});
+    velocities.push_back({speed(rng), speed(rng), speed(rng)});
+    proxies.push_back(bvh.insert(boxes.back(), i));
+  }
+  std::cout << "Built BVH over " << OBJECT_COUNT << " objects in " << millisecondsSince(start) << " ms";
+  std::cout << " (height " << bvh.getHeight() << ")\n";
+
+  const kdr::space::Frustum frustum = kdr::space::extractFrustum(
+    kdr::space::perspective(60.f, 16.f / 9.f, 0.1f, 400.f) *
+    kdr::space::lookAt({0.f, 0.f, 0.f}, {1.f, 0.f, -1.f}, {0.f, 1.f, 0.f})
+  );
+  const kdr::space::AABB queryBox {{-25.f, -25.f, -25.f}, {25.f, 25.f, 25.f}};
+  const kdr::space::Ray  queryRay {{-WORLD_SIZE / 2.f, 0.f, 0.f}, {1.f, 0.f, 0.f}};
+
+  std::vector<uint32_t> results;
+  kdr::space::AABBArray packedBoxes;
+  double moveTime         {0.0};
+  double bvhFrustumTime   {0.0};
+  double bvhBoxTime       {0.0};
+  double bvhRayTime       {0.0};
+  double bruteFrustumTime {0.0};
+  double simdFrustumTime  {0.0};
+  double bruteBoxTime     {0.0};
+  size_t bvhVisible       {0};
+  size_t bruteVisible     {0};
+  size_t reinsertions     {0};
+  size_t bvhOverlapping   {0};
+  size_t bruteOverlapping {0};
+
+  for (int frame = 0; frame < FRAME_COUNT; frame++)
+  {
+    start = Clock::now();
+    for (int i = 0; i < OBJECT_COUNT; i++)
+    {
+      boxes[i].min += velocities[i];
+      boxes[i].max += velocities[i];
+      reinsertions += bvh.move(proxies[i], boxes[i], velocities[i]);
+    }
+    moveTime += millisecondsSince(start);
+
+    start = Clock::now();
+    bvh.queryFrustum(frustum, results);
+    bvhFrustumTime += millisecondsSince(start);
+    bvhVisible += results.size();
+
+    start = Clock::now();
+    bvh.queryAABB(queryBox, results);
+    bvhBoxTime += millisecondsSince(start);
+    bvhOverlapping += results.size();
+
+    start = Clock::now();
+    bvh.queryRay(queryRay, WORLD_SIZE, results);
+    bvhRayTime += millisecondsSince(start);
+
+    start = Clock::now();
+    size_t visible = 0;
+    for (const kdr::space::AABB& box : boxes)
+    {
+      visible += kdr::space::isVisible(frustum, box);
+    }
+    bruteFrustumTime += millisecondsSince(start);
+    bruteVisible += visible;
+
+    start = Clock::now();
+    packedBoxes.clear();
+    for (const kdr::space::AABB& box : boxes)
+    {
+      packedBoxes.add(box);
+    }
+    kdr::space::cullAABBs(frustum, packedBoxes, results);
+    simdFrustumTime += millisecondsSince(start);
+
+    start = Clock::now();
+    size_t overlapping = 0;
+    for (const kdr::space::AABB& box : boxes)
+    {
+      overlapping += overlapsBox(box, queryBox);
+    }
+    bruteBoxTime += millisecondsSince(start);
+    bruteOverlapping += overlapping;
+  }
+
+  std::cout << "Average per frame over " << FRAME_COUNT << " frames:\n";
+  std::cout << "  BVH move:              " << moveTime / FRAME_COUNT << " ms (" << reinsertions / FRAME_COUNT << " reinsertions)\n";
+  std::cout << "  BVH frustum query:     " << bvhFrustumTime / FRAME_COUNT << " ms (" << bvhVisible / FRAME_COUNT << " candidates)\n";
+  std::cout << "  Brute frustum test:    " << bruteFrustumTime / FRAME_COUNT << " ms (" << bruteVisible / FRAME_COUNT << " visible)\n";
+  std::cout << "  Packed SIMD culling:   " << simdFrustumTime / FRAME_COUNT << " ms\n";
+  std::cout << "  BVH AABB query:        " << bvhBoxTime / FRAME_COUNT << " ms (" << bvhOverlapping / FRAME_COUNT << " candidates)\n";
+  std::cout << "  Brute AABB test:       " << bruteBoxTime / FRAME_COUNT << " ms (" << bruteOverlapping / FRAME_COUNT << " overlapping)\n";
+  std::cout << "  BVH ray query:         " << bvhRayTime / FRAME_COUNT << " ms\n";
+
+  return 0;
+}
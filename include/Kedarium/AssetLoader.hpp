@@ -0,0 +1,244 @@
+#ifndef KDR_ASSET_LOADER_HPP
+#define KDR_ASSET_LOADER_HPP
+
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Graphics.hpp"
+#include "Image.hpp"
+#include "ProgramCache.hpp"
+#include "TextureFile.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Loads textures and shaders on a pool of worker threads.
+     *
+     * Workers read and decode the files: images and texture files through
+     * kdr::img, GLSL sources (includes expanded) through kdr::file. Each
+     * finished job is pushed onto a lock-free queue that Update() drains on
+     * the GL thread, which then only creates the OpenGL objects. Shader
+     * programs are submitted to the driver and picked up once built, so
+     * they never block Update() with parallel shader compilation available.
+     */
+    class AssetLoader
+    {
+      public:
+        /**
+         * Handle to an asset requested from the loader.
+         */
+        using Handle = size_t;
+        /**
+         * Called on the GL thread once an asset is ready or failed to load.
+         */
+        using CompletionCallback = std::function<void(Handle handle, bool isLoaded)>;
+        /**
+         * Called on the GL thread after every completed asset.
+         */
+        using ProgressCallback = std::function<void(size_t completedCount, size_t requestedCount)>;
+
+        /**
+         * Constructs an AssetLoader and starts its worker threads.
+         *
+         * @param workerCount The number of loading threads, or 0 for one per hardware thread minus one.
+         * @param cache The program binary cache used for shaders, or NULL to always build from source.
+         */
+        AssetLoader(unsigned int workerCount = 0, kdr::gfx::ProgramCache* cache = NULL);
+        /**
+         * Stops the worker threads.
+         */
+        ~AssetLoader();
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        /**
+         * Gets a loaded texture.
+         *
+         * @param handle The handle returned by LoadTexture().
+         * @return The texture, or NULL if it is not loaded (yet).
+         */
+        kdr::gfx::Texture* getTexture(const Handle handle) const
+        { return this->jobs[handle]->texture.get(); }
+        /**
+         * Gets a loaded shader.
+         *
+         * @param handle The handle returned by LoadShader().
+         * @return The shader, or NULL if it is not loaded (yet).
+         */
+        kdr::gfx::Shader* getShader(const Handle handle) const
+        { return this->jobs[handle]->shader.get(); }
+        /**
+         * Gets the number of requested assets that are ready or failed.
+         *
+         * @return The number of completed assets.
+         */
+        size_t getCompletedCount() const
+        { return this->completedCount; }
+        /**
+         * Gets the number of requested assets.
+         *
+         * @return The number of requests.
+         */
+        size_t getRequestedCount() const
+        { return this->jobs.size(); }
+        /**
+         * Gets whether every requested asset is ready or failed.
+         *
+         * @return True if nothing is pending, false otherwise.
+         */
+        bool isDone() const
+        { return this->completedCount == this->jobs.size(); }
+        /**
+         * Sets the callback called after every completed asset.
+         *
+         * @param callback The progress callback.
+         */
+        void setProgressCallback(const ProgressCallback& callback)
+        { this->progressCallback = callback; }
+
+        /**
+         * Requests a texture from an image or texture file. Returns immediately.
+         *
+         * @param path The file path to the PNG, QOI or raw image, or texture file.
+         * @param sampler The sampling parameters.
+         * @param callback Called once the texture is ready or failed, or NULL.
+         * @return The handle of the texture.
+         */
+        Handle LoadTexture(
+          const std::string& path,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState(),
+          const CompletionCallback& callback = NULL
+        );
+        /**
+         * Requests a shader program. Returns immediately.
+         *
+         * @param vertexPath The file path to the vertex shader.
+         * @param fragmentPath The file path to the fragment shader.
+         * @param callback Called once the shader is ready or failed, or NULL.
+         * @return The handle of the shader.
+         */
+        Handle LoadShader(
+          const std::string& vertexPath,
+          const std::string& fragmentPath,
+          const CompletionCallback& callback = NULL
+        );
+        /**
+         * Creates the OpenGL objects of the assets the workers have finished.
+         * Call on the GL thread, once per frame or in a loop until isDone().
+         *
+         * @param uploadBudget The number of decoded bytes uploaded per call. At least one asset is uploaded.
+         */
+        void Update(size_t uploadBudget = (size_t)-1);
+        /**
+         * Stops the worker threads and deletes every loaded texture and shader.
+         */
+        void Delete();
+
+      private:
+        /**
+         * Progress of a request. Steps marked (W) run on a worker thread, the others on the GL thread.
+         */
+        enum class Stage
+        {
+          Reading,  // (W)
+          Decoded,
+          Building,
+          Ready,
+          Failed,
+        };
+
+        /**
+         * State of one requested asset, and its node in the decoded queue.
+         */
+        struct Job
+        {
+          std::atomic<Job*> next {NULL};
+
+          Handle             handle;
+          bool               isShader {false};
+          std::string        paths[2];
+          Stage              stage    {Stage::Reading};
+          CompletionCallback callback;
+
+          // Texture
+          kdr::gfx::SamplerState sampler;
+          bool                   isTextureFile {false};
+          kdr::img::Image        image;
+          kdr::img::TextureFile  textureFile;
+          std::unique_ptr<kdr::gfx::Texture> texture;
+
+          // Shader
+          std::string            sources[2];
+          kdr::gfx::ShaderFuture future;
+          std::unique_ptr<kdr::gfx::Shader> shader;
+        };
+
+        kdr::gfx::ProgramCache* cache;
+
+        std::vector<std::unique_ptr<Job>> jobs;
+        std::deque<Job*>                  uploads;
+        std::vector<Job*>                 building;
+        size_t                            completedCount {0};
+        ProgressCallback                  progressCallback;
+
+        std::vector<std::thread> workers;
+        std::deque<Job*>         workQueue;
+        std::mutex               workMutex;
+        std::condition_variable  workCondition;
+        bool                     stopping {false};
+
+        // Decoded jobs, multiple producers (workers) and a single consumer (GL thread)
+        Job                decodedStub;
+        std::atomic<Job*>  decodedHead {&decodedStub};
+        Job*               decodedTail {&decodedStub};
+
+        /**
+         * Takes jobs from the work queue until the loader stops.
+         */
+        void _work();
+        /**
+         * Stops and joins the worker threads.
+         */
+        void _stop();
+        /**
+         * Queues a new job for the worker threads.
+         *
+         * @param job The job.
+         * @return The handle of the job.
+         */
+        Handle _submit(std::unique_ptr<Job> job);
+        /**
+         * Pushes a decoded job. Wait-free, callable from any thread.
+         *
+         * @param job The job.
+         */
+        void _pushDecoded(Job* job);
+        /**
+         * Pops a decoded job. GL thread only.
+         *
+         * @return The job, or NULL if none is available.
+         */
+        Job* _popDecoded();
+        /**
+         * Marks a job ready or failed and calls its callbacks.
+         *
+         * @param job The job.
+         * @param isLoaded Whether the asset is ready.
+         */
+        void _complete(Job& job, const bool isLoaded);
+    };
+  }
+}
+
+#endif // KDR_ASSET_LOADER_HPP
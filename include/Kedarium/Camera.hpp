@@ -7,6 +7,7 @@
 
 #include "Keys.hpp"
 #include "Space.hpp"
+#include "Culling.hpp"
 
 namespace kdr
 {
@@ -60,6 +61,43 @@ namespace kdr
         sensitivity(cameraProps.sensitivity)
       {}
 
+      /**
+       * Gets the combined projection and view matrix of the camera.
+       *
+       * @return The camera matrix computed by the last updateMatrix() call.
+       */
+      const kdr::space::Mat4& getMatrix() const
+      { return this->matrix; }
+      /**
+       * Gets the view matrix of the camera.
+       *
+       * @return The view matrix computed by the last updateMatrix() call.
+       */
+      const kdr::space::Mat4& getView() const
+      { return this->view; }
+      /**
+       * Gets the projection matrix of the camera.
+       *
+       * @return The projection matrix computed by the last updateMatrix() call.
+       */
+      const kdr::space::Mat4& getProjection() const
+      { return this->projection; }
+      /**
+       * Gets the position of the eye in world space. The view translates the
+       * world by the camera position, so the eye sits at its negation.
+       *
+       * @return The eye position.
+       */
+      kdr::space::Vec3 getEyePosition() const
+      { return -this->position; }
+      /**
+       * Gets the view frustum of the camera.
+       *
+       * @return The frustum extracted by the last updateMatrix() call.
+       */
+      const kdr::space::Frustum& getFrustum() const
+      { return this->frustum; }
+
       /**
        * Sets the aspect ratio of the camera.
        *
@@ -76,16 +114,15 @@ namespace kdr
       { this->isMouseLocked = locked; }
 
       /**
-       * Updates the internal transformation matrix of the camera.
+       * Updates the internal transformation matrix and view frustum of the camera.
        */
       void updateMatrix();
       /**
-       * Applies the camera matrix to a shader uniform.
+       * Applies the camera matrix to a uniform of the shader program in use.
        *
-       * @param shaderID The ID of the shader program.
-       * @param uniformName The name of the uniform variable in the shader.
+       * @param location The location of the mat4 uniform, resolved once by the caller.
        */
-      void applyMatrix(const GLuint shaderID, const std::string& uniformName);
+      void applyMatrix(const GLint location);
       /**
        * Handles camera movement based on user input.
        *
@@ -107,7 +144,10 @@ namespace kdr
       float speed       {1.f};
       float sensitivity {12.f};
 
-      kdr::space::Mat4 matrix;
+      kdr::space::Mat4    view;
+      kdr::space::Mat4    projection;
+      kdr::space::Mat4    matrix;
+      kdr::space::Frustum frustum;
       kdr::space::Vec3 position {0.f,  0.f, -5.f};
       kdr::space::Vec3 up       {0.f, -1.f,  0.f};
       kdr::space::Vec3 front    {0.f,  0.f, -1.f};
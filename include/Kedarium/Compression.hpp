@@ -0,0 +1,53 @@
+#ifndef KDR_COMPRESSION_HPP
+#define KDR_COMPRESSION_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace kdr
+{
+  namespace img
+  {
+    /**
+     * Gets the number of 4x4 blocks covering an image dimension.
+     *
+     * @param size The width or height of the image.
+     * @return The number of blocks.
+     */
+    constexpr int getBlockCount(const int size)
+    { return (size + 3) / 4; }
+
+    /**
+     * Compresses RGBA8 pixels to BC1 (8 bytes per 4x4 block, alpha ignored).
+     * Blocks are stored row by row in the order of the pixel rows.
+     *
+     * @param pixels The RGBA8 pixels.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param output Receives the compressed blocks.
+     */
+    void encodeBC1(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output);
+    /**
+     * Compresses RGBA8 pixels to BC3 (16 bytes per 4x4 block, interpolated alpha).
+     *
+     * @param pixels The RGBA8 pixels.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param output Receives the compressed blocks.
+     */
+    void encodeBC3(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output);
+    /**
+     * Compresses RGBA8 pixels to BC7 (16 bytes per 4x4 block). Every block
+     * uses mode 6: one RGBA endpoint pair and 16 interpolation steps.
+     *
+     * @param pixels The RGBA8 pixels.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param output Receives the compressed blocks.
+     */
+    void encodeBC7(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output);
+  }
+}
+
+#endif // KDR_COMPRESSION_HPP
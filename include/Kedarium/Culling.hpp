@@ -0,0 +1,201 @@
+#ifndef KDR_CULLING_HPP
+#define KDR_CULLING_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "Space.hpp"
+
+namespace kdr
+{
+  namespace space
+  {
+    /**
+     * Plane in 3D space. Points p with dot(normal, p) + distance >= 0 lie on its positive side.
+     */
+    struct Plane
+    {
+      kdr::space::Vec3 normal;
+      float distance {0.f};
+    };
+
+    /**
+     * View frustum made of six inward-facing planes.
+     */
+    struct Frustum
+    {
+      /**
+       * Indices of the frustum planes.
+       */
+      enum Side
+      {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count,
+      };
+
+      kdr::space::Plane planes[Side::Count];
+    };
+
+    /**
+     * Bounding sphere described by a center and a radius.
+     */
+    struct Sphere
+    {
+      kdr::space::Vec3 center;
+      float radius {0.f};
+    };
+
+    /**
+     * Axis-aligned bounding box described by its minimum and maximum corners.
+     */
+    struct AABB
+    {
+      kdr::space::Vec3 min;
+      kdr::space::Vec3 max;
+    };
+
+    /**
+     * Packed structure-of-arrays storage for bounding spheres.
+     */
+    struct SphereArray
+    {
+      std::vector<float> xs;
+      std::vector<float> ys;
+      std::vector<float> zs;
+      std::vector<float> radii;
+
+      /**
+       * Appends a bounding sphere.
+       *
+       * @param sphere The sphere to append.
+       */
+      void add(const kdr::space::Sphere& sphere)
+      {
+        this->xs.push_back(sphere.center.x);
+        this->ys.push_back(sphere.center.y);
+        this->zs.push_back(sphere.center.z);
+        this->radii.push_back(sphere.radius);
+      }
+      /**
+       * Gets the number of stored spheres.
+       *
+       * @return The number of spheres.
+       */
+      size_t size() const
+      { return this->radii.size(); }
+      /**
+       * Removes all stored spheres.
+       */
+      void clear()
+      {
+        this->xs.clear();
+        this->ys.clear();
+        this->zs.clear();
+        this->radii.clear();
+      }
+    };
+
+    /**
+     * Packed structure-of-arrays storage for axis-aligned bounding boxes,
+     * kept as centers and half extents.
+     */
+    struct AABBArray
+    {
+      std::vector<float> centerXs;
+      std::vector<float> centerYs;
+      std::vector<float> centerZs;
+      std::vector<float> extentXs;
+      std::vector<float> extentYs;
+      std::vector<float> extentZs;
+
+      /**
+       * Appends an axis-aligned bounding box.
+       *
+       * @param box The box to append.
+       */
+      void add(const kdr::space::AABB& box)
+      {
+        this->centerXs.push_back((box.min.x + box.max.x) * 0.5f);
+        this->centerYs.push_back((box.min.y + box.max.y) * 0.5f);
+        this->centerZs.push_back((box.min.z + box.max.z) * 0.5f);
+        this->extentXs.push_back((box.max.x - box.min.x) * 0.5f);
+        this->extentYs.push_back((box.max.y - box.min.y) * 0.5f);
+        this->extentZs.push_back((box.max.z - box.min.z) * 0.5f);
+      }
+      /**
+       * Gets the number of stored boxes.
+       *
+       * @return The number of boxes.
+       */
+      size_t size() const
+      { return this->centerXs.size(); }
+      /**
+       * Removes all stored boxes.
+       */
+      void clear()
+      {
+        this->centerXs.clear();
+        this->centerYs.clear();
+        this->centerZs.clear();
+        this->extentXs.clear();
+        this->extentYs.clear();
+        this->extentZs.clear();
+      }
+    };
+
+    /**
+     * Extracts the normalized frustum planes from a view-projection matrix.
+     *
+     * @param mat The view-projection matrix.
+     * @return The frustum with planes facing inwards.
+     */
+    kdr::space::Frustum extractFrustum(const kdr::space::Mat4& mat);
+    /**
+     * Tests whether a bounding sphere intersects a frustum.
+     *
+     * @param frustum The frustum to test against.
+     * @param sphere The bounding sphere.
+     * @return True if the sphere is at least partially inside, false otherwise.
+     */
+    bool isVisible(const kdr::space::Frustum& frustum, const kdr::space::Sphere& sphere);
+    /**
+     * Tests whether an axis-aligned bounding box intersects a frustum.
+     *
+     * @param frustum The frustum to test against.
+     * @param box The axis-aligned bounding box.
+     * @return True if the box is at least partially inside, false otherwise.
+     */
+    bool isVisible(const kdr::space::Frustum& frustum, const kdr::space::AABB& box);
+    /**
+     * Tests packed bounding spheres against a frustum, 8 (AVX) or 4 (SSE/NEON) at a time.
+     *
+     * @param frustum The frustum to test against.
+     * @param spheres The packed bounding spheres.
+     * @param visibleIndices Receives the ascending indices of the visible spheres.
+     */
+    void cullSpheres(
+      const kdr::space::Frustum& frustum,
+      const kdr::space::SphereArray& spheres,
+      std::vector<uint32_t>& visibleIndices
+    );
+    /**
+     * Tests packed axis-aligned bounding boxes against a frustum, 8 (AVX) or 4 (SSE/NEON) at a time.
+     *
+     * @param frustum The frustum to test against.
+     * @param boxes The packed axis-aligned bounding boxes.
+     * @param visibleIndices Receives the ascending indices of the visible boxes.
+     */
+    void cullAABBs(
+      const kdr::space::Frustum& frustum,
+      const kdr::space::AABBArray& boxes,
+      std::vector<uint32_t>& visibleIndices
+    );
+  }
+}
+
+#endif // KDR_CULLING_HPP
@@ -4,14 +4,164 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace kdr
 {
   namespace file
   {
     /**
-     * Reads the contents of a file and returns it as a string.
+     * Read-only view of a whole file. Disk files are memory-mapped, stored
+     * pack entries point into the pack mapping and compressed pack entries
+     * are inflated into memory owned by the view. Mounted packs are searched
+     * before the disk (see kdr::file::mountPack()). Move-only.
+     */
+    class FileView
+    {
+      public:
+        /**
+         * Constructs a closed FileView.
+         */
+        FileView() = default;
+        /**
+         * Unmaps the file.
+         */
+        ~FileView();
+
+        FileView(FileView&& other);
+        FileView& operator=(FileView&& other);
+        FileView(const FileView&) = delete;
+        FileView& operator=(const FileView&) = delete;
+
+        /**
+         * Gets whether a file is open.
+         *
+         * @return True if open, false otherwise.
+         */
+        bool isOpen() const
+        { return this->data != NULL; }
+        /**
+         * Gets the contents of the file.
+         *
+         * @return The contents, valid until the view is closed.
+         */
+        const char* getData() const
+        { return this->data; }
+        /**
+         * Gets the size of the file.
+         *
+         * @return The size in bytes.
+         */
+        size_t getSize() const
+        { return this->size; }
+        /**
+         * Gets the contents of the file.
+         *
+         * @return The contents, valid until the view is closed.
+         */
+        std::string_view getView() const
+        { return std::string_view(this->data, this->size); }
+
+        /**
+         * Opens a file, closing the file opened before.
+         *
+         * @param path The path to the file.
+         * @return True if the file is opened successfully, false otherwise.
+         */
+        bool open(const std::string& path);
+        /**
+         * Closes the file, invalidating its contents.
+         */
+        void close();
+
+      private:
+        const char* data        {NULL};
+        size_t      size        {0};
+        void*       mapping     {NULL};
+        std::string inflated;
+        bool        isInflated  {false};
+    };
+
+    /**
+     * Sequential reader handing out a file in chunks, for files too large to
+     * hold at once. Disk files are read into one reused buffer, mounted pack
+     * entries are handed out from the pack without copying. Move-only.
+     */
+    class ChunkReader
+    {
+      public:
+        /**
+         * Constructs a closed ChunkReader.
+         *
+         * @param chunkSize The largest chunk read at once, in bytes.
+         */
+        ChunkReader(const size_t chunkSize = 64 * 1024);
+        /**
+         * Closes the file.
+         */
+        ~ChunkReader();
+
+        ChunkReader(ChunkReader&& other);
+        ChunkReader& operator=(ChunkReader&& other);
+        ChunkReader(const ChunkReader&) = delete;
+        ChunkReader& operator=(const ChunkReader&) = delete;
+
+        /**
+         * Gets the size of the file.
+         *
+         * @return The size in bytes.
+         */
+        size_t getSize() const
+        { return this->size; }
+        /**
+         * Gets the number of bytes read so far.
+         *
+         * @return The position in bytes.
+         */
+        size_t getPosition() const
+        { return this->position; }
+        /**
+         * Gets whether the whole file is read.
+         *
+         * @return True at the end of the file, false otherwise.
+         */
+        bool isEnd() const
+        { return this->position == this->size; }
+
+        /**
+         * Opens a file, closing the file opened before.
+         *
+         * @param path The path to the file.
+         * @return True if the file is opened successfully, false otherwise.
+         */
+        bool open(const std::string& path);
+        /**
+         * Closes the file.
+         */
+        void close();
+        /**
+         * Reads the next chunk.
+         *
+         * @param chunk Receives the chunk, valid until the next read() or close(). Empty at the end of the file.
+         * @return True if the chunk is read successfully, false otherwise.
+         */
+        bool read(std::string_view& chunk);
+
+      private:
+        size_t                  chunkSize;
+        int                     file     {-1};
+        std::unique_ptr<char[]> buffer;
+        const char*             packed   {NULL};
+        std::string             inflated;
+        size_t                  size     {0};
+        size_t                  position {0};
+    };
+
+    /**
+     * Reads the contents of a file and returns it as a string. Prefer a
+     * kdr::file::FileView, which reads without copying.
      *
      * @param path The path to the file to be read.
      * @return A string containing the contents of the file.
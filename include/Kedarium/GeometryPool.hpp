@@ -0,0 +1,142 @@
+#ifndef KDR_GEOMETRY_POOL_HPP
+#define KDR_GEOMETRY_POOL_HPP
+
+#include <GL/glew.h>
+#include <stdint.h>
+#include <vector>
+
+#include "State.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Location of a mesh inside a GeometryPool.
+     */
+    struct MeshRange
+    {
+      GLuint firstIndex  {0};
+      GLuint indexCount  {0};
+      GLint  baseVertex  {0};
+      GLuint vertexCount {0};
+    };
+
+    /**
+     * Indirect draw command, laid out as glMultiDrawElementsIndirect expects it.
+     */
+    struct DrawElementsIndirectCommand
+    {
+      GLuint count;
+      GLuint instanceCount;
+      GLuint firstIndex;
+      GLint  baseVertex;
+      GLuint baseInstance;
+    };
+
+    /**
+     * Shared vertex and index buffers holding many meshes of one vertex
+     * format behind a single VAO. Any subset of the meshes is drawn with one
+     * glMultiDrawElementsIndirect call, or one glMultiDrawElementsBaseVertex
+     * call when indirect draws are unavailable.
+     */
+    class GeometryPool
+    {
+      public:
+        /**
+         * Constructs a GeometryPool and allocates its buffers.
+         *
+         * @param vertexStride The size of one vertex in bytes.
+         * @param maxVertices The number of vertices the pool can hold.
+         * @param maxIndices The number of indices the pool can hold.
+         */
+        GeometryPool(GLsizei vertexStride, GLuint maxVertices, GLuint maxIndices);
+
+        /**
+         * Gets the ID of the VAO shared by all meshes.
+         *
+         * @return The OpenGL identifier (ID) of the VAO.
+         */
+        GLuint getVAOID() const
+        { return this->vaoID; }
+        /**
+         * Gets the location of a mesh.
+         *
+         * @param meshID The ID returned by AddMesh().
+         * @return The index and vertex ranges of the mesh.
+         */
+        const kdr::gfx::MeshRange& getMesh(const uint32_t meshID) const
+        { return this->meshes[meshID]; }
+        /**
+         * Gets the number of meshes in the pool.
+         *
+         * @return The number of meshes.
+         */
+        size_t getMeshCount() const
+        { return this->meshes.size(); }
+        /**
+         * Gets whether draws go through glMultiDrawElementsIndirect.
+         *
+         * @return True if indirect draws are supported, false for the base vertex fallback.
+         */
+        bool isIndirect() const
+        { return this->indirect; }
+
+        /**
+         * Links an attribute of the shared vertex format.
+         *
+         * @param layout The attribute layout location.
+         * @param size The number of components per attribute.
+         * @param type The data type of each component.
+         * @param offset The byte offset of the attribute inside a vertex.
+         */
+        void LinkAttribute(GLuint layout, GLuint size, GLenum type, GLsizeiptr offset);
+        /**
+         * Copies a mesh into the pool. Indices are relative to the mesh's own vertices.
+         *
+         * @param vertices The vertex data, vertexCount * vertexStride bytes.
+         * @param vertexCount The number of vertices.
+         * @param indices The index data.
+         * @param indexCount The number of indices.
+         * @return The mesh ID, or -1 if the pool is full.
+         */
+        int AddMesh(const void* vertices, GLuint vertexCount, const GLuint* indices, GLuint indexCount);
+        /**
+         * Draws a list of meshes with a single multi-draw call. The shader
+         * program must be in use. Each draw gets its position in the list as
+         * base instance when drawn indirectly.
+         *
+         * @param meshIDs The IDs of the meshes to draw, e.g. the visible ones.
+         * @param mode The primitive type (e.g., GL_TRIANGLES).
+         */
+        void Draw(const std::vector<uint32_t>& meshIDs, GLenum mode = GL_TRIANGLES);
+        /**
+         * Deletes the buffers and VAO of the pool.
+         */
+        void Delete();
+
+      private:
+        GLuint vaoID;
+        GLuint vertexBufferID;
+        GLuint indexBufferID;
+        GLuint indirectBufferID {0};
+        bool   indirect {false};
+
+        GLsizei vertexStride;
+        GLuint  maxVertices;
+        GLuint  maxIndices;
+        GLuint  vertexCount {0};
+        GLuint  indexCount  {0};
+
+        std::vector<kdr::gfx::MeshRange> meshes;
+        std::vector<kdr::gfx::DrawElementsIndirectCommand> commands;
+        GLsizeiptr indirectCapacity {0};
+
+        std::vector<GLsizei>     counts;
+        std::vector<const void*> offsets;
+        std::vector<GLint>       baseVertices;
+    };
+  }
+}
+
+#endif // KDR_GEOMETRY_POOL_HPP
@@ -3,9 +3,18 @@
 
 #include <GL/glew.h>
 #include <iostream>
+#include <string>
+#include <unordered_map>
 
 #include "File.hpp"
 #include "Image.hpp"
+#include "ImageFormat.hpp"
+#include "Pixel.hpp"
+#include "Space.hpp"
+#include "ProgramCache.hpp"
+#include "State.hpp"
+#include "StreamBuffer.hpp"
+#include "TextureFile.hpp"
 
 namespace kdr
 {
@@ -26,6 +35,55 @@ namespace kdr
      */
     inline void useFillMode()
     { glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); }
+    /**
+     * Draws several instances of indexed geometry with a single draw call.
+     *
+     * @param mode The primitive type (e.g., GL_TRIANGLES).
+     * @param count The number of indices per instance.
+     * @param type The data type of the indices.
+     * @param offset The byte offset of the first index in the bound EBO.
+     * @param instanceCount The number of instances to draw.
+     */
+    inline void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* offset, GLsizei instanceCount)
+    { glDrawElementsInstanced(mode, count, type, offset, instanceCount); }
+    /**
+     * Checks whether the driver can sample a pixel format.
+     *
+     * @param format The pixel format.
+     * @return True if textures of the format can be created, false otherwise.
+     */
+    bool isFormatSupported(const kdr::img::PixelFormat format);
+
+    /**
+     * Active uniform or vertex attribute of a linked shader program.
+     */
+    struct ShaderVariable
+    {
+      GLint  location {-1};
+      GLenum type     {GL_NONE};
+      GLint  size     {0};
+    };
+
+    /**
+     * Uniform block binding point of the FrameConstants block.
+     */
+    constexpr GLuint FRAME_CONSTANTS_BINDING {0};
+
+    /**
+     * Values shared by every shader for one frame, laid out like the std140
+     * FrameConstants block declared in resources/Shaders/FrameConstants.glsl.
+     */
+    struct FrameConstants
+    {
+      kdr::space::Mat4 view;
+      kdr::space::Mat4 projection;
+      kdr::space::Mat4 viewProjection;
+      kdr::space::Vec4 cameraPosition;
+      float time        {0.f};
+      float padding[3]  {0.f, 0.f, 0.f};
+    };
+
+    class ShaderFuture;
 
     /**
      * Shader class for handling vertex and fragment shaders.
@@ -38,8 +96,15 @@ namespace kdr
          *
          * @param vertexPath The file path to the vertex shader.
          * @param fragmentPath The file path to the fragment shader.
+         * @param cache The program binary cache to link from and refresh, or NULL to always build from source.
+         */
+        Shader(const std::string& vertexPath, const std::string& fragmentPath, kdr::gfx::ProgramCache* cache = NULL);
+        /**
+         * Constructs a Shader from a pending build, waiting for it to finish.
+         *
+         * @param future The build returned by compileShader().
          */
-        Shader(const std::string& vertexPath, const std::string& fragmentPath);
+        Shader(kdr::gfx::ShaderFuture&& future);
 
         /**
          * Gets the ID of the shader program.
@@ -49,21 +114,233 @@ namespace kdr
         GLuint getID() const
         { return this->ID; }
 
+        /**
+         * Gets the active uniforms reflected when the program was linked.
+         *
+         * @return The uniforms keyed by name, with array names stripped of their "[0]" suffix.
+         */
+        const std::unordered_map<std::string, kdr::gfx::ShaderVariable>& getUniforms() const
+        { return this->uniforms; }
+        /**
+         * Gets the active vertex attributes reflected when the program was linked.
+         *
+         * @return The attributes keyed by name.
+         */
+        const std::unordered_map<std::string, kdr::gfx::ShaderVariable>& getAttributes() const
+        { return this->attributes; }
+        /**
+         * Gets the active uniform blocks reflected when the program was linked.
+         * A block named FrameConstants is bound to FRAME_CONSTANTS_BINDING.
+         *
+         * @return The uniform block indices keyed by name.
+         */
+        const std::unordered_map<std::string, GLuint>& getUniformBlocks() const
+        { return this->uniformBlocks; }
+        /**
+         * Gets the location of an active uniform. Meant to be called once at
+         * setup, keeping the result as the handle passed to the setters.
+         *
+         * @param name The name of the uniform variable in the shader.
+         * @return The uniform location, or -1 if the uniform is not active.
+         */
+        GLint getUniformLocation(const std::string& name) const;
+        /**
+         * Gets the location of an active vertex attribute.
+         *
+         * @param name The name of the attribute in the shader.
+         * @return The attribute location, or -1 if the attribute is not active.
+         */
+        GLint getAttributeLocation(const std::string& name) const;
+
+        /**
+         * Sets an int (or sampler) uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setInt(const GLint location, const int value) const
+        { glUniform1i(location, value); }
+        /**
+         * Sets a float uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setFloat(const GLint location, const float value) const
+        { glUniform1f(location, value); }
+        /**
+         * Sets a vec2 uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setVec2(const GLint location, const kdr::space::Vec2& value) const
+        { glUniform2f(location, value.x, value.y); }
+        /**
+         * Sets a vec3 uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setVec3(const GLint location, const kdr::space::Vec3& value) const
+        { glUniform3f(location, value.x, value.y, value.z); }
+        /**
+         * Sets a vec4 uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setVec4(const GLint location, const kdr::space::Vec4& value) const
+        { glUniform4f(location, value.x, value.y, value.z, value.w); }
+        /**
+         * Sets a mat3 uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setMat3(const GLint location, const kdr::space::Mat3& value) const
+        { glUniformMatrix3fv(location, 1, GL_FALSE, kdr::space::valuePointer(value)); }
+        /**
+         * Sets a mat4 uniform of the shader program, which must be in use.
+         *
+         * @param location The location returned by getUniformLocation().
+         * @param value The value to set.
+         */
+        void setMat4(const GLint location, const kdr::space::Mat4& value) const
+        { glUniformMatrix4fv(location, 1, GL_FALSE, kdr::space::valuePointer(value)); }
+
         /**
          * Uses the shader program.
          */
         void Use()
-        { glUseProgram(this->ID); }
+        { kdr::gfx::getStateCache().useProgram(this->ID); }
         /**
          * Deletes the shader program, freeing up associated resources in the GPU.
          */
         void Delete()
-        { glDeleteProgram(this->ID); }
+        {
+          glDeleteProgram(this->ID);
+          kdr::gfx::getStateCache().forgetProgram(this->ID);
+        }
 
       private:
         GLuint ID;
+        std::unordered_map<std::string, kdr::gfx::ShaderVariable> uniforms;
+        std::unordered_map<std::string, kdr::gfx::ShaderVariable> attributes;
+        std::unordered_map<std::string, GLuint> uniformBlocks;
+
+        /**
+         * Queries the active uniforms, attributes and uniform blocks of the linked program.
+         */
+        void _reflect();
     };
 
+    /**
+     * Handle to a shader program whose compilation and linking were submitted
+     * to the driver but not waited on. With GL_KHR_parallel_shader_compile the
+     * driver builds programs on its own threads and isReady() polls them
+     * without blocking; otherwise every status query is deferred to the
+     * construction of the Shader, so submitting many programs up front still
+     * lets the driver overlap them.
+     *
+     * The handle owns the pending program and its shader objects, so it can
+     * only be moved. Consume it with Shader(std::move(future)), or release
+     * it with Delete() if the program is no longer wanted.
+     */
+    class ShaderFuture
+    {
+      public:
+        /**
+         * Constructs a handle that owns no program.
+         */
+        ShaderFuture() = default;
+
+        ShaderFuture(ShaderFuture&& other);
+        ShaderFuture& operator=(ShaderFuture&& other);
+        ShaderFuture(const ShaderFuture&) = delete;
+        ShaderFuture& operator=(const ShaderFuture&) = delete;
+
+        /**
+         * Gets whether the handle still owns a pending program.
+         *
+         * @return False once the program was passed to a Shader, true otherwise.
+         */
+        bool isValid() const
+        { return this->programID != 0; }
+        /**
+         * Checks whether the program finished building, without blocking.
+         *
+         * @return True if constructing the Shader will not wait on the driver
+         * compiler, or if completion cannot be queried without waiting.
+         */
+        bool isReady() const;
+
+        /**
+         * Deletes the pending program and its shader objects without waiting for them.
+         */
+        void Delete();
+
+      private:
+        GLuint   programID      {0};
+        GLuint   vertexShader   {0};
+        GLuint   fragmentShader {0};
+        uint64_t key            {0};
+
+        kdr::gfx::ProgramCache* cache {NULL};
+
+        friend class kdr::gfx::Shader;
+        friend kdr::gfx::ShaderFuture compileShaderSource(
+          const std::string& vertexSource,
+          const std::string& fragmentSource,
+          kdr::gfx::ProgramCache* cache
+        );
+
+        /**
+         * Checks the compile and link status, releasing the shader objects.
+         *
+         * @return True if the program linked, false otherwise.
+         */
+        bool _finish();
+    };
+
+    /**
+     * Submits a shader program for compilation and linking without waiting
+     * for the driver. Pass the result to the Shader constructor once needed.
+     *
+     * @param vertexPath The file path to the vertex shader.
+     * @param fragmentPath The file path to the fragment shader.
+     * @param cache The program binary cache to link from and refresh, or NULL to always build from source.
+     * @return The handle to the pending program.
+     */
+    kdr::gfx::ShaderFuture compileShader(
+      const std::string& vertexPath,
+      const std::string& fragmentPath,
+      kdr::gfx::ProgramCache* cache = NULL
+    );
+    /**
+     * Submits a shader program built from sources already in memory (see
+     * loadShaderSource()) for compilation and linking without waiting.
+     *
+     * @param vertexSource The vertex shader source.
+     * @param fragmentSource The fragment shader source.
+     * @param cache The program binary cache to link from and refresh, or NULL to always build from source.
+     * @return The handle to the pending program.
+     */
+    kdr::gfx::ShaderFuture compileShaderSource(
+      const std::string& vertexSource,
+      const std::string& fragmentSource,
+      kdr::gfx::ProgramCache* cache = NULL
+    );
+    /**
+     * Reads a shader source, expanding its #include "file" directives
+     * relative to the including file. Makes no OpenGL calls, so it can run
+     * on any thread.
+     *
+     * @param path The file path to the shader.
+     * @return The expanded source, or an empty string if the file cannot be read.
+     */
+    std::string loadShaderSource(const std::string& path);
+
     /**
      * Vertex Buffer Object (VBO) class for handling vertex data.
      */
@@ -90,17 +367,20 @@ namespace kdr
          * Binds the VBO to the OpenGL context.
          */
         void Bind()
-        { glBindBuffer(GL_ARRAY_BUFFER, this->ID); }
+        { kdr::gfx::getStateCache().bindBuffer(GL_ARRAY_BUFFER, this->ID); }
         /**
          * Unbinds the currently bound VBO from the OpenGL context.
          */
         void Unbind()
-        { glBindBuffer(GL_ARRAY_BUFFER, 0); }
+        { kdr::gfx::getStateCache().bindBuffer(GL_ARRAY_BUFFER, 0); }
         /**
          * Deletes the VBO, freeing up associated resources in the GPU.
          */
         void Delete()
-        { glDeleteBuffers(1, &this->ID); }
+        {
+          glDeleteBuffers(1, &this->ID);
+          kdr::gfx::getStateCache().forgetBuffer(this->ID);
+        }
 
       private:
         GLuint ID;
@@ -132,22 +412,139 @@ namespace kdr
          * Binds the EBO to the OpenGL context.
          */
         void Bind()
-        { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID); }
+        { kdr::gfx::getStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID); }
         /**
          * Unbinds the currently bound EBO from the OpenGL context.
          */
         void Unbind()
-        { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
+        { kdr::gfx::getStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
         /**
          * Deletes the EBO, freeing up associated resources in the GPU.
          */
         void Delete()
-        { glDeleteBuffers(1, &this->ID); }
+        {
+          glDeleteBuffers(1, &this->ID);
+          kdr::gfx::getStateCache().forgetBuffer(this->ID);
+        }
 
       private:
         GLuint ID;
     };
 
+    /**
+     * Instance Buffer class for per-instance attribute data that is rewritten
+     * often, such as instance transforms.
+     */
+    class InstanceBuffer
+    {
+      public:
+        /**
+         * Constructs an InstanceBuffer with storage for the given number of bytes.
+         *
+         * @param capacity The initial size of the buffer in bytes.
+         */
+        InstanceBuffer(GLsizeiptr capacity);
+
+        /**
+         * Gets the ID of the instance buffer.
+         *
+         * @return The OpenGL identifier (ID) of the buffer.
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * Gets the size of the buffer storage.
+         *
+         * @return The capacity of the buffer in bytes.
+         */
+        GLsizeiptr getCapacity() const
+        { return this->capacity; }
+
+        /**
+         * Replaces the contents of the buffer, growing it when needed. The old
+         * storage is orphaned so that the upload never waits on draws still
+         * reading it.
+         *
+         * @param data The instance data.
+         * @param size The size of the instance data in bytes.
+         */
+        void Update(const void* data, GLsizeiptr size);
+        /**
+         * Binds the instance buffer to the OpenGL context.
+         */
+        void Bind()
+        { kdr::gfx::getStateCache().bindBuffer(GL_ARRAY_BUFFER, this->ID); }
+        /**
+         * Unbinds the currently bound instance buffer from the OpenGL context.
+         */
+        void Unbind()
+        { kdr::gfx::getStateCache().bindBuffer(GL_ARRAY_BUFFER, 0); }
+        /**
+         * Deletes the instance buffer, freeing up associated resources in the GPU.
+         */
+        void Delete()
+        {
+          glDeleteBuffers(1, &this->ID);
+          kdr::gfx::getStateCache().forgetBuffer(this->ID);
+        }
+
+      private:
+        GLuint     ID;
+        GLsizeiptr capacity {0};
+    };
+
+    /**
+     * Uniform Buffer Object (UBO) class for uniform blocks shared by several
+     * shader programs.
+     */
+    class UniformBuffer
+    {
+      public:
+        /**
+         * Constructs a UniformBuffer and attaches it to a binding point.
+         *
+         * @param size The size of the uniform block in bytes.
+         * @param binding The uniform block binding point.
+         */
+        UniformBuffer(GLsizeiptr size, GLuint binding);
+
+        /**
+         * Gets the ID of the uniform buffer.
+         *
+         * @return The OpenGL identifier (ID) of the buffer.
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * Gets the binding point of the uniform buffer.
+         *
+         * @return The uniform block binding point.
+         */
+        GLuint getBinding() const
+        { return this->binding; }
+
+        /**
+         * Replaces the contents of the buffer, orphaning the old storage.
+         *
+         * @param data The block data.
+         * @param size The size of the block data in bytes, at most the buffer size.
+         */
+        void Update(const void* data, GLsizeiptr size);
+        /**
+         * Deletes the uniform buffer, freeing up associated resources in the GPU.
+         */
+        void Delete()
+        {
+          glDeleteBuffers(1, &this->ID);
+          kdr::gfx::getStateCache().forgetBuffer(this->ID);
+        }
+
+      private:
+        GLuint     ID;
+        GLuint     binding;
+        GLsizeiptr size;
+    };
+
     /**
      * Vertex Array Object (VAO) class for handling vertex array data.
      */
@@ -179,26 +576,82 @@ namespace kdr
          * @param offset The byte offset of the first component in the attribute.
          */
         void LinkAttribute(kdr::gfx::VBO& VBO, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset);
+        /**
+         * Links a per-instance attribute of an instance buffer to the VAO.
+         *
+         * @param buffer The instance buffer containing the attribute data.
+         * @param layout The attribute layout location.
+         * @param size The number of components per attribute.
+         * @param type The data type of each component.
+         * @param stride The byte offset between consecutive instances.
+         * @param offset The byte offset of the first component in the attribute.
+         * @param divisor The number of instances sharing each attribute value.
+         */
+        void LinkAttribute(kdr::gfx::InstanceBuffer& buffer, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset, GLuint divisor = 1);
+        /**
+         * Links a per-instance mat4 attribute of an instance buffer to the VAO.
+         * The matrix takes four consecutive locations, one per column.
+         *
+         * @param buffer The instance buffer containing the matrices.
+         * @param layout The location of the first column.
+         * @param stride The byte offset between consecutive instances.
+         * @param offset The byte offset of the first matrix.
+         * @param divisor The number of instances sharing each matrix.
+         */
+        void LinkMatrixAttribute(kdr::gfx::InstanceBuffer& buffer, GLuint layout, GLsizeiptr stride, const void* offset, GLuint divisor = 1);
         /**
          * Binds the VAO to the OpenGL context.
          */
         void Bind()
-        { glBindVertexArray(this->ID); }
+        { kdr::gfx::getStateCache().bindVertexArray(this->ID); }
         /**
          * Unbinds the currently bound VAO from the OpenGL context.
          */
         void Unbind()
-        { glBindVertexArray(0); }
+        { kdr::gfx::getStateCache().bindVertexArray(0); }
         /**
          * Deletes the VAO, freeing up associated resources in the GPU.
          */
         void Delete()
-        { glDeleteVertexArrays(1, &this->ID); }
+        {
+          glDeleteVertexArrays(1, &this->ID);
+          kdr::gfx::getStateCache().forgetVertexArray(this->ID);
+        }
 
       private:
         GLuint ID;
     };
 
+    /**
+     * Sampling parameters of a texture. The defaults keep magnified texels
+     * sharp and blend between mip levels when minifying; use
+     * GL_LINEAR_MIPMAP_LINEAR and GL_LINEAR for trilinear filtering.
+     */
+    struct SamplerState
+    {
+      GLenum minFilter     {GL_NEAREST_MIPMAP_LINEAR};
+      GLenum magFilter     {GL_NEAREST};
+      GLenum wrapS         {GL_REPEAT};
+      GLenum wrapT         {GL_REPEAT};
+      float  maxAnisotropy {1.f}; // Clamped to the driver limit, ignored without anisotropic filtering
+    };
+
+    /**
+     * Applies sampling parameters to the texture bound to a target.
+     *
+     * @param type The target the texture is bound to (e.g., GL_TEXTURE_2D).
+     * @param sampler The sampling parameters.
+     */
+    void applySampler(GLenum type, const kdr::gfx::SamplerState& sampler);
+    /**
+     * Gets whether a minification filter samples the mip levels.
+     *
+     * @param filter The minification filter.
+     * @return False for GL_NEAREST and GL_LINEAR, true otherwise.
+     */
+    constexpr bool isMipmapFilter(const GLenum filter)
+    { return filter != GL_NEAREST && filter != GL_LINEAR; }
+
     /**
      * A class for handling OpenGL textures.
      */
@@ -206,15 +659,55 @@ namespace kdr
     {
       public:
         /**
-         * Constructor for creating a texture from an image file.
+         * Constructor for creating a texture from an image file. Texture files
+         * (see kdr::img::TextureFile) are recognized by their magic and upload
+         * their stored levels as they are, compressed or not; any other file is
+         * decoded by kdr::img::loadImage (PNG, QOI or raw, told apart by their
+         * signature), stored by its channel count as the Image constructor
+         * does, and mipmapped as the Image constructor does.
          *
-         * @param imagePath The file path to the PNG image.
+         * @param imagePath The file path to the PNG, QOI or raw image, or texture file.
          * @param type The type of the texture (e.g., GL_TEXTURE_2D).
          * @param slot The texture unit slot to bind the texture to.
-         * @param format The internal format of the texture.
-         * @param pixelType The data type of the pixel data.
+         * @param sampler The sampling parameters.
+         */
+        Texture(
+          const std::string& imagePath,
+          GLenum type,
+          GLenum slot,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState()
+        );
+        /**
+         * Constructor for creating a texture from a decoded image, mipmapped with glGenerateMipmap
+         * when the sampler's minification filter samples mips and stored as its base level only
+         * otherwise. Gray and gray-alpha images are stored in 1 and 2 channels and swizzled back
+         * to gray RGB, RGB images are expanded to RGBA on the CPU.
+         *
+         * @param image The image, with 1 to 4 channels.
+         * @param type The type of the texture (e.g., GL_TEXTURE_2D).
+         * @param slot The texture unit slot to bind the texture to.
+         * @param sampler The sampling parameters.
+         */
+        Texture(
+          const kdr::img::Image& image,
+          GLenum type,
+          GLenum slot,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState()
+        );
+        /**
+         * Constructor for creating a texture from a loaded texture file, uploading its stored levels.
+         *
+         * @param textureFile The texture file.
+         * @param type The type of the texture (e.g., GL_TEXTURE_2D).
+         * @param slot The texture unit slot to bind the texture to.
+         * @param sampler The sampling parameters.
          */
-        Texture(const std::string& imagePath, GLenum type, GLenum slot, GLenum format, GLenum pixelType);
+        Texture(
+          const kdr::img::TextureFile& textureFile,
+          GLenum type,
+          GLenum slot,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState()
+        );
 
          /**
          * Gets the ID of the texture.
@@ -223,34 +716,101 @@ namespace kdr
          */
         const GLuint getID() const
         { return this->ID; }
+        /**
+         * Gets the width of the base mip level.
+         *
+         * @return The width of the texture in texels.
+         */
+        int getWidth() const
+        { return this->width; }
+        /**
+         * Gets the height of the base mip level.
+         *
+         * @return The height of the texture in texels.
+         */
+        int getHeight() const
+        { return this->height; }
+        /**
+         * Gets the video memory of the texture, mip levels included.
+         *
+         * @return The estimated size in bytes.
+         */
+        size_t getMemorySize() const
+        { return this->memorySize; }
+        /**
+         * Sets the sampling parameters. Binds the texture to the active texture unit.
+         * A texture created without mips keeps sampling its base level under a mipmap filter.
+         *
+         * @param sampler The sampling parameters.
+         */
+        void setSampler(const kdr::gfx::SamplerState& sampler);
 
         /**
-         * Sets the texture unit of a shader uniform variable.
+         * Sets the texture unit of a shader sampler uniform. Uses the shader program.
          *
-         * @param shaderID The ID of the shader program.
-         * @param uniform The name of the uniform variable in the shader.
+         * @param shader The shader program.
+         * @param uniform The name of the sampler uniform in the shader.
          * @param unit The texture unit to bind.
          */
-        void TextureUnit(const GLuint shaderID, const std::string& uniform, GLuint unit);
+        void TextureUnit(kdr::gfx::Shader& shader, const std::string& uniform, GLuint unit);
         /**
          * Binds the texture to the OpenGL context.
          */
         void Bind()
-        { glBindTexture(this->type, this->ID); }
+        { kdr::gfx::getStateCache().bindTexture(this->type, this->ID); }
         /**
          * Unbinds the currently bound texture from the OpenGL context.
          */
         void Unbind()
-        { glBindTexture(this->type, 0); }
+        { kdr::gfx::getStateCache().bindTexture(this->type, 0); }
         /**
          * Deletes the texture, freeing up associated resources in the GPU.
          */
         void Delete()
-        { glDeleteTextures(1, &this->ID); }
+        {
+          glDeleteTextures(1, &this->ID);
+          kdr::gfx::getStateCache().forgetTexture(this->ID);
+        }
 
       private:
         GLuint ID;
         GLenum type;
+        int    width      {0};
+        int    height     {0};
+        size_t memorySize {0};
+        kdr::gfx::SamplerState sampler;
+
+        /**
+         * Generates the texture and binds it to a texture unit.
+         *
+         * @param slot The texture unit slot.
+         * @param sampler The sampling parameters.
+         */
+        void _generate(GLenum slot, const kdr::gfx::SamplerState& sampler);
+        /**
+         * Uploads the base level of an image to the bound texture and generates its mipmaps
+         * if the minification filter samples them.
+         *
+         * @param pixels The pixel data.
+         * @param internalFormat The internal format of the texture.
+         * @param format The format of the pixel data.
+         * @param pixelType The data type of the pixel data.
+         * @param texelSize The size of a texel in video memory, in bytes.
+         */
+        void _uploadImage(const void* pixels, GLenum internalFormat, GLenum format, GLenum pixelType, const int texelSize);
+        /**
+         * Uploads a decoded image to the bound texture in the format matching its channel count.
+         *
+         * @param image The image, with 1 to 4 channels.
+         */
+        void _uploadDecodedImage(const kdr::img::Image& image);
+        /**
+         * Uploads every level of a texture file to the bound texture.
+         *
+         * @param textureFile The texture file.
+         * @param path The file path, for error messages.
+         */
+        void _uploadTextureFile(const kdr::img::TextureFile& textureFile, const std::string& path);
     };
   };
 }
@@ -3,25 +3,248 @@
 
 #include <GL/glew.h>
 #include <png.h>
+#include <stdint.h>
 #include <string.h>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 
 namespace kdr
 {
   namespace img
   {
+    /**
+     * Decoded 8-bit image, rows stored bottom row first as OpenGL expects.
+     * Move-only: the pixels are either owned and freed with the image, or
+     * borrowed from a caller buffer or a ScratchAllocator that outlives it.
+     */
+    class Image
+    {
+      public:
+        /**
+         * Constructs an empty image.
+         */
+        Image() = default;
+        /**
+         * Constructs an image owning uninitialized pixels.
+         *
+         * @param width The width of the image.
+         * @param height The height of the image.
+         * @param channels The number of 8-bit channels per pixel (1 to 4).
+         */
+        Image(const int width, const int height, const int channels);
+        /**
+         * Constructs an image borrowing pixels it does not free.
+         *
+         * @param pixels The pixels, width * height * channels bytes.
+         * @param width The width of the image.
+         * @param height The height of the image.
+         * @param channels The number of 8-bit channels per pixel (1 to 4).
+         */
+        Image(GLubyte* pixels, const int width, const int height, const int channels);
+        /**
+         * Frees the pixels if owned.
+         */
+        ~Image();
+
+        Image(Image&& other);
+        Image& operator=(Image&& other);
+        Image(const Image&) = delete;
+        Image& operator=(const Image&) = delete;
+
+        /**
+         * Gets the width of the image.
+         *
+         * @return The width in pixels.
+         */
+        int getWidth() const
+        { return this->width; }
+        /**
+         * Gets the height of the image.
+         *
+         * @return The height in pixels.
+         */
+        int getHeight() const
+        { return this->height; }
+        /**
+         * Gets the number of channels per pixel.
+         *
+         * @return The number of 8-bit channels (1 to 4).
+         */
+        int getChannels() const
+        { return this->channels; }
+        /**
+         * Gets the size of the pixels.
+         *
+         * @return The size in bytes.
+         */
+        size_t getSize() const
+        { return (size_t)this->width * this->height * this->channels; }
+        /**
+         * Gets the pixels.
+         *
+         * @return The pixels, bottom row first, or NULL if the image is empty.
+         */
+        GLubyte* getData()
+        { return this->data; }
+        /**
+         * Gets the pixels.
+         *
+         * @return The pixels, bottom row first, or NULL if the image is empty.
+         */
+        const GLubyte* getData() const
+        { return this->data; }
+        /**
+         * Gets whether the image frees its pixels.
+         *
+         * @return True if the pixels are owned, false if borrowed.
+         */
+        bool isOwner() const
+        { return this->owner; }
+        /**
+         * Gets whether the image has no pixels.
+         *
+         * @return True if empty, false otherwise.
+         */
+        bool isEmpty() const
+        { return this->data == NULL; }
+
+      private:
+        GLubyte* data     {NULL};
+        int      width    {0};
+        int      height   {0};
+        int      channels {0};
+        bool     owner    {false};
+
+        /**
+         * Frees the pixels if owned and empties the image.
+         */
+        void _reset();
+    };
+
+    /**
+     * Reusable decode memory. Keeps its largest allocation between images, so
+     * a thread decoding many transient images (e.g., uploaded and dropped)
+     * only allocates when an image is larger than every one before it. Not
+     * thread-safe: use one allocator per thread.
+     */
+    class ScratchAllocator
+    {
+      public:
+        /**
+         * Gets the size of the kept allocation.
+         *
+         * @return The capacity in bytes.
+         */
+        size_t getCapacity() const
+        { return this->capacity; }
+
+        /**
+         * Gets memory for one image, invalidating the memory returned before.
+         *
+         * @param size The size in bytes.
+         * @return The memory, valid until the next allocate() or release().
+         */
+        GLubyte* allocate(const size_t size);
+        /**
+         * Frees the kept allocation.
+         */
+        void release();
+
+      private:
+        std::unique_ptr<GLubyte[]> buffer;
+        size_t                     capacity {0};
+    };
+
+    /**
+     * Decodes a PNG already in memory, such as an open file view, row by row into
+     * the memory returned by getBuffer, last row first so the image ends up bottom
+     * row first. Lets a caller that has read the file to detect its format decode
+     * it without opening it again.
+     *
+     * @param pngPath The file path of the PNG, used in error messages.
+     * @param bytes The contents of the PNG file.
+     * @param size The size of the contents in bytes.
+     * @param isRGBA Whether to expand every image to 4 channels, adding gray to RGB and opaque alpha.
+     * @param getBuffer Returns the memory for the decoded width, height and channels, or NULL to fail.
+     * @return True if the image is decoded successfully, false otherwise. The memory may be partly written on failure.
+     */
+    bool decodePNG(
+      const std::string& pngPath,
+      const uint8_t* bytes,
+      const size_t size,
+      const bool isRGBA,
+      const std::function<GLubyte*(int width, int height, int channels)>& getBuffer
+    );
+    /**
+     * Decodes a PNG file row by row straight into the image pixels, with no
+     * intermediate copy. Palettes, low bit depths and transparency are
+     * expanded to 8 bits per channel and 16-bit channels are stripped to 8.
+     * Mounted packs are searched before the disk (see kdr::file::mountPack()).
+     *
+     * @param pngPath The file path to the PNG image.
+     * @param image Receives the image, owning its pixels unless scratch is given.
+     * @param isRGBA Whether to expand every image to 4 channels, adding gray to RGB and opaque alpha.
+     * @param scratch The allocator to decode into, or NULL to allocate the pixels.
+     * @return True if the image is loaded successfully, false otherwise, leaving the image empty.
+     */
+    bool loadPNG(
+      const std::string& pngPath,
+      kdr::img::Image& image,
+      const bool isRGBA = false,
+      kdr::img::ScratchAllocator* scratch = NULL
+    );
+    /**
+     * Decodes a PNG file row by row into a caller buffer, such as a mapped pixel buffer object.
+     *
+     * @param pngPath The file path to the PNG image.
+     * @param buffer The memory to decode into.
+     * @param capacity The size of the buffer in bytes. Larger images fail to load.
+     * @param image Receives the image, borrowing the buffer.
+     * @param isRGBA Whether to expand every image to 4 channels, adding gray to RGB and opaque alpha.
+     * @return True if the image is loaded successfully, false otherwise, leaving the image empty.
+     */
+    bool loadPNG(
+      const std::string& pngPath,
+      GLubyte* buffer,
+      const size_t capacity,
+      kdr::img::Image& image,
+      const bool isRGBA = false
+    );
+
     /**
      * Loads image data from a PNG file.
      *
      * @param pngPath The file path to the PNG image.
      * @param data A pointer to the location where the image data will be stored.
-     *             The memory is allocated inside the function and needs to be freed by the caller.
+     *             The memory is allocated inside the function and needs to be released by the caller with free().
      * @param imgWidth Reference to store the width of the loaded image.
      * @param imgHeight Reference to store the height of the loaded image.
      * @return True if the image is loaded successfully, false otherwise.
      */
     bool loadFromPNG(const std::string& pngPath, GLubyte** data, int& imgWidth, int& imgHeight);
+    /**
+     * Loads image data from a PNG file, reporting its number of channels.
+     *
+     * @param pngPath The file path to the PNG image.
+     * @param data A pointer to the location where the image data will be stored.
+     *             The memory is allocated inside the function and needs to be released by the caller with free().
+     * @param imgWidth Reference to store the width of the loaded image.
+     * @param imgHeight Reference to store the height of the loaded image.
+     * @param channels Reference to store the number of 8-bit channels per pixel (1 to 4).
+     * @return True if the image is loaded successfully, false otherwise.
+     */
+    bool loadFromPNG(const std::string& pngPath, GLubyte** data, int& imgWidth, int& imgHeight, int& channels);
+    /**
+     * Reads the dimensions of a PNG image from its header, without decoding it.
+     *
+     * @param pngPath The file path to the PNG image.
+     * @param imgWidth Reference to store the width of the image.
+     * @param imgHeight Reference to store the height of the image.
+     * @return True if the header is valid, false otherwise.
+     */
+    bool getPNGSize(const std::string& pngPath, int& imgWidth, int& imgHeight);
   }
 }
 
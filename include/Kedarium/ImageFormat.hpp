@@ -0,0 +1,99 @@
+#ifndef KDR_IMAGE_FORMAT_HPP
+#define KDR_IMAGE_FORMAT_HPP
+
+#include <GL/glew.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "Image.hpp"
+
+namespace kdr
+{
+  namespace img
+  {
+    /**
+     * Lossless image file formats, told apart by their signature.
+     */
+    enum class ImageFormat
+    {
+      Unknown,
+      PNG,
+      QOI, // "Quite OK Image" format, decodes several times faster than PNG at a similar size
+      Raw, // Uncompressed pixels as kdr::img::Image stores them, behind a 16-byte header
+    };
+
+    /**
+     * Reads the signature of an image file.
+     *
+     * @param path The file path.
+     * @return The format of the file, or ImageFormat::Unknown if it cannot be read or is not an image.
+     */
+    kdr::img::ImageFormat getImageFormat(const std::string& path);
+    /**
+     * Reads the dimensions of a PNG, QOI or raw image from its header, without decoding it.
+     *
+     * @param path The file path to the image.
+     * @param width Reference to store the width of the image.
+     * @param height Reference to store the height of the image.
+     * @return True if the header is valid, false otherwise.
+     */
+    bool getImageSize(const std::string& path, int& width, int& height);
+    /**
+     * Decodes a PNG, QOI or raw image, picking the decoder from the file signature.
+     * Without isRGBA the image keeps the channel count of the file: 1 to 4 for PNG
+     * and raw images, 3 or 4 for QOI. Check kdr::img::Image::getChannels() before
+     * handing the pixels to code that expects a fixed layout.
+     *
+     * @param path The file path to the image.
+     * @param image Receives the image, owning its pixels unless scratch is given.
+     * @param isRGBA Whether to expand every image to 4 channels, adding gray to RGB and opaque alpha.
+     * @param scratch The allocator to decode into, or NULL to allocate the pixels.
+     * @return True if the image is loaded successfully, false otherwise, leaving the image empty.
+     */
+    bool loadImage(
+      const std::string& path,
+      kdr::img::Image& image,
+      const bool isRGBA = false,
+      kdr::img::ScratchAllocator* scratch = NULL
+    );
+    /**
+     * Decodes a PNG, QOI or raw image into a caller buffer, such as a mapped pixel buffer object.
+     * Channels are kept as in the other overload unless isRGBA is set.
+     *
+     * @param path The file path to the image.
+     * @param buffer The memory to decode into.
+     * @param capacity The size of the buffer in bytes. Larger images fail to load.
+     * @param image Receives the image, borrowing the buffer.
+     * @param isRGBA Whether to expand every image to 4 channels, adding gray to RGB and opaque alpha.
+     * @return True if the image is loaded successfully, false otherwise, leaving the image empty.
+     */
+    bool loadImage(
+      const std::string& path,
+      GLubyte* buffer,
+      const size_t capacity,
+      kdr::img::Image& image,
+      const bool isRGBA = false
+    );
+
+    /**
+     * Encodes an image as QOI. QOI has no gray formats, so gray images are stored
+     * as RGB and gray-alpha as RGBA; use a raw image to keep 1 or 2 channels.
+     *
+     * @param path The file path of the QOI image to write.
+     * @param image The image.
+     * @return True if the image is saved successfully, false otherwise.
+     */
+    bool saveQOI(const std::string& path, const kdr::img::Image& image);
+    /**
+     * Writes an image uncompressed, loading with a single copy.
+     *
+     * @param path The file path of the raw image to write.
+     * @param image The image.
+     * @return True if the image is saved successfully, false otherwise.
+     */
+    bool saveRawImage(const std::string& path, const kdr::img::Image& image);
+  }
+}
+
+#endif // KDR_IMAGE_FORMAT_HPP
@@ -0,0 +1,54 @@
+#ifndef KDR_MIPMAP_HPP
+#define KDR_MIPMAP_HPP
+
+#include <stdint.h>
+#include <vector>
+
+namespace kdr
+{
+  namespace img
+  {
+    /**
+     * Downsampling filter used between two mip levels.
+     */
+    enum class MipFilter
+    {
+      Box,    // 2x2 average, cheapest
+      Kaiser, // 8-tap Kaiser-windowed sinc, sharper and with less aliasing
+    };
+
+    /**
+     * Gets the number of levels of a full mip chain.
+     *
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @return The number of levels down to 1x1, base level included.
+     */
+    int getMipLevelCount(int width, int height);
+
+    /**
+     * Generates the full mip chain of an RGBA8 image on the CPU. Filtering
+     * runs in linear space: with isSRGB the color channels are decoded from
+     * sRGB first and encoded back after, alpha is always linear. Every level
+     * is filtered from the unquantized previous one. The function keeps no
+     * state and can run on several threads at once.
+     *
+     * @param pixels The RGBA8 pixels of the base level.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @param filter The downsampling filter.
+     * @param isSRGB Whether the color channels are sRGB encoded.
+     * @param levels Receives the RGBA8 levels, the base level included.
+     */
+    void generateMipChain(
+      const uint8_t* pixels,
+      const int width,
+      const int height,
+      const kdr::img::MipFilter filter,
+      const bool isSRGB,
+      std::vector<std::vector<uint8_t>>& levels
+    );
+  }
+}
+
+#endif // KDR_MIPMAP_HPP
@@ -0,0 +1,170 @@
+#ifndef KDR_PACK_HPP
+#define KDR_PACK_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace kdr
+{
+  namespace file
+  {
+    /**
+     * Compression of a pack entry.
+     */
+    enum class PackCompression : uint32_t
+    {
+      None, // Stored, served straight from the mapping
+      Zlib, // Deflate, inflated into a buffer on every read
+    };
+
+    /**
+     * Table of contents record of one file in a pack.
+     */
+    struct PackEntry
+    {
+      uint64_t hash;        // FNV-1a of the normalized path
+      uint64_t offset;      // From the start of the pack, aligned to PACK_ALIGNMENT
+      uint64_t storedSize;  // Bytes in the pack
+      uint64_t size;        // Bytes once decompressed
+      uint32_t nameOffset;  // Into the name table
+      uint32_t nameLength;
+      kdr::file::PackCompression compression;
+      uint32_t reserved;
+    };
+
+    /**
+     * Alignment of the entry data in a pack, in bytes.
+     */
+    constexpr uint64_t PACK_ALIGNMENT {64};
+
+    /**
+     * Read-only archive of files, memory-mapped once as a whole.
+     *
+     * On disk: a header (magic "KPAK", version, entry count, name table size,
+     * table of contents offset, name table offset), the table of contents
+     * sorted by path hash then path, the name table, then the entry data.
+     * Paths are normalized (e.g., "./a/../b.png" is "b.png") and use '/'.
+     */
+    class Pack
+    {
+      public:
+        /**
+         * Constructs a closed Pack.
+         */
+        Pack() = default;
+        /**
+         * Unmaps the pack.
+         */
+        ~Pack();
+
+        Pack(const Pack&) = delete;
+        Pack& operator=(const Pack&) = delete;
+
+        /**
+         * Gets whether a pack is mapped.
+         *
+         * @return True if open, false otherwise.
+         */
+        bool isOpen() const
+        { return this->mapping != NULL; }
+        /**
+         * Gets the number of files in the pack.
+         *
+         * @return The number of entries.
+         */
+        size_t getEntryCount() const
+        { return this->entryCount; }
+
+        /**
+         * Maps a pack file and validates its table of contents.
+         *
+         * @param path The file path to the pack.
+         * @return True if the pack is opened successfully, false otherwise.
+         */
+        bool open(const std::string& path);
+        /**
+         * Unmaps the pack, invalidating every pointer into it.
+         */
+        void close();
+        /**
+         * Looks a file up by path.
+         *
+         * @param path The path of the file.
+         * @return The entry, or NULL if the pack does not contain the file.
+         */
+        const kdr::file::PackEntry* find(const std::string& path) const;
+        /**
+         * Gets the stored bytes of an entry, without copying.
+         *
+         * @param entry The entry.
+         * @return The stored bytes, valid until the pack is closed.
+         */
+        const char* getStoredData(const kdr::file::PackEntry& entry) const
+        { return (const char*)this->mapping + entry.offset; }
+        /**
+         * Gets the contents of an entry. Stored entries are not copied: data
+         * points into the mapping. Compressed entries are inflated into the
+         * buffer, which data then points into.
+         *
+         * @param entry The entry.
+         * @param data Receives the contents.
+         * @param buffer Holds the contents of compressed entries.
+         * @return True if the contents are read successfully, false otherwise.
+         */
+        bool read(const kdr::file::PackEntry& entry, const char*& data, std::string& buffer) const;
+
+      private:
+        void*                       mapping    {NULL};
+        size_t                      size       {0};
+        const kdr::file::PackEntry* entries    {NULL};
+        size_t                      entryCount {0};
+        const char*                 names      {NULL};
+    };
+
+    /**
+     * Normalizes a path the way pack entries are named.
+     *
+     * @param path The path.
+     * @return The lexically normal path with '/' separators.
+     */
+    std::string normalizePath(const std::string& path);
+
+    /**
+     * Writes a pack from files on disk, named by their path as given.
+     *
+     * @param packPath The file path of the pack to write.
+     * @param filePaths The files to pack.
+     * @param compress Whether to deflate the entries that shrink by an eighth or more.
+     * @return True if the pack is written successfully, false otherwise.
+     */
+    bool writePack(const std::string& packPath, const std::vector<std::string>& filePaths, const bool compress);
+
+    /**
+     * Mounts a pack so that the file loaders (kdr::file, kdr::img and the
+     * shader loader) look paths up in it before the disk. Later mounts take
+     * precedence. Mount before loading from other threads.
+     *
+     * @param packPath The file path to the pack.
+     * @return True if the pack is mounted successfully, false otherwise.
+     */
+    bool mountPack(const std::string& packPath);
+    /**
+     * Unmounts every pack, invalidating the data read from them without copy.
+     */
+    void unmountPacks();
+    /**
+     * Reads a file from the mounted packs.
+     *
+     * @param path The path of the file.
+     * @param data Receives the contents, pointing into a pack or into the buffer (see Pack::read()).
+     * @param size Receives the size of the contents.
+     * @param buffer Holds the contents of compressed entries.
+     * @return True if a mounted pack contains the file, false otherwise.
+     */
+    bool readPacked(const std::string& path, const char*& data, size_t& size, std::string& buffer);
+  }
+}
+
+#endif // KDR_PACK_HPP
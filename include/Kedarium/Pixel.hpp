@@ -0,0 +1,68 @@
+#ifndef KDR_PIXEL_HPP
+#define KDR_PIXEL_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace kdr
+{
+  namespace img
+  {
+    /**
+     * Expands RGB8 pixels to RGBA8 with opaque alpha.
+     *
+     * @param input The RGB8 pixels.
+     * @param output Receives the RGBA8 pixels. Must not overlap the input.
+     * @param pixelCount The number of pixels.
+     */
+    void expandRGBToRGBA(const uint8_t* input, uint8_t* output, const size_t pixelCount);
+    /**
+     * Swaps the red and blue channels of 4-channel pixels, converting
+     * between RGBA8 and BGRA8.
+     *
+     * @param input The RGBA8 or BGRA8 pixels.
+     * @param output Receives the swizzled pixels. May be the input.
+     * @param pixelCount The number of pixels.
+     */
+    void swapRedBlue(const uint8_t* input, uint8_t* output, const size_t pixelCount);
+    /**
+     * Multiplies the color channels of RGBA8 pixels by their alpha, rounded
+     * to the nearest. Premultiply before filtering (e.g., generating mips)
+     * so transparent texels do not bleed their color.
+     *
+     * @param input The RGBA8 pixels.
+     * @param output Receives the premultiplied pixels. May be the input.
+     * @param pixelCount The number of pixels.
+     */
+    void premultiplyAlpha(const uint8_t* input, uint8_t* output, const size_t pixelCount);
+    /**
+     * Converts RGBA8 pixels to floats in [0, 1].
+     *
+     * @param input The RGBA8 pixels.
+     * @param output Receives the RGBA float pixels.
+     * @param pixelCount The number of pixels.
+     * @param isSRGB Whether to decode the color channels from sRGB to linear. Alpha is always linear.
+     */
+    void decodePixels(const uint8_t* input, float* output, const size_t pixelCount, const bool isSRGB);
+    /**
+     * Converts RGBA float pixels to RGBA8, clamping them to [0, 1] and
+     * rounding to the nearest.
+     *
+     * @param input The RGBA float pixels.
+     * @param output Receives the RGBA8 pixels.
+     * @param pixelCount The number of pixels.
+     * @param isSRGB Whether to encode the color channels from linear to sRGB. Alpha is always linear.
+     */
+    void encodePixels(const float* input, uint8_t* output, const size_t pixelCount, const bool isSRGB);
+    /**
+     * Flips an image vertically, in place.
+     *
+     * @param pixels The pixels.
+     * @param rowSize The size of a row in bytes.
+     * @param height The number of rows.
+     */
+    void flipRows(uint8_t* pixels, const size_t rowSize, const int height);
+  }
+}
+
+#endif // KDR_PIXEL_HPP
@@ -0,0 +1,98 @@
+#ifndef KDR_PROGRAM_CACHE_HPP
+#define KDR_PROGRAM_CACHE_HPP
+
+#include <GL/glew.h>
+#include <stdint.h>
+#include <string>
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Counters describing how a ProgramCache has been used.
+     */
+    struct ProgramCacheStats
+    {
+      size_t hits       {0};
+      size_t misses     {0};
+      size_t rejections {0};
+      size_t stores     {0};
+    };
+
+    /**
+     * On-disk cache of linked shader program binaries. Entries are keyed by a
+     * hash of the shader sources and the driver vendor, renderer and version
+     * strings, so a driver update invalidates them instead of feeding stale
+     * binaries to glProgramBinary.
+     */
+    class ProgramCache
+    {
+      public:
+        /**
+         * Constructs a ProgramCache storing its entries in a directory.
+         *
+         * @param directory The directory holding the cached binaries, created if missing.
+         */
+        ProgramCache(const std::string& directory);
+
+        /**
+         * Gets whether the driver can save and restore program binaries.
+         *
+         * @return True if at least one binary format is available, false otherwise.
+         */
+        bool isSupported() const
+        { return this->supported; }
+        /**
+         * Gets the hit, miss, rejection and store counters.
+         *
+         * @return The cache statistics.
+         */
+        const kdr::gfx::ProgramCacheStats& getStats() const
+        { return this->stats; }
+
+        /**
+         * Computes the cache key of a program.
+         *
+         * @param vertexSource The vertex shader source.
+         * @param fragmentSource The fragment shader source.
+         * @return The key combining the sources with the driver identification.
+         */
+        uint64_t makeKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+        /**
+         * Loads a cached binary into a program object. A binary rejected by
+         * the driver is counted and left to be overwritten by store().
+         *
+         * @param key The key returned by makeKey().
+         * @param programID The program object to load into.
+         * @return True if the program was linked from the cache, false otherwise.
+         */
+        bool load(const uint64_t key, const GLuint programID);
+        /**
+         * Saves the binary of a linked program. The program should have been
+         * linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+         *
+         * @param key The key returned by makeKey().
+         * @param programID The linked program object.
+         */
+        void store(const uint64_t key, const GLuint programID);
+
+      private:
+        std::string directory;
+        std::string driver;
+        bool        supported {false};
+
+        kdr::gfx::ProgramCacheStats stats;
+
+        /**
+         * Gets the path of the file holding an entry.
+         *
+         * @param key The key of the entry.
+         * @return The path of the entry file.
+         */
+        std::string _getEntryPath(const uint64_t key) const;
+    };
+  }
+}
+
+#endif // KDR_PROGRAM_CACHE_HPP
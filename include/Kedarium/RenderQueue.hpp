@@ -0,0 +1,105 @@
+#ifndef KDR_RENDER_QUEUE_HPP
+#define KDR_RENDER_QUEUE_HPP
+
+#include <GL/glew.h>
+#include <stdint.h>
+#include <vector>
+
+#include "State.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Passes of a frame, executed in this order.
+     */
+    enum class RenderPass : uint8_t
+    {
+      Opaque,
+      Transparent,
+      Overlay,
+    };
+
+    /**
+     * Indexed draw recorded by a RenderQueue.
+     */
+    struct DrawCommand
+    {
+      GLuint      shaderID      {0};
+      GLuint      vaoID         {0};
+      GLuint      textureID     {0};
+      GLenum      textureType   {GL_TEXTURE_2D};
+      GLenum      mode          {GL_TRIANGLES};
+      GLsizei     count         {0};
+      GLenum      indexType     {GL_UNSIGNED_INT};
+      const void* offset        {NULL};
+      GLsizei     instanceCount {1};
+    };
+
+    /**
+     * Queue of draw commands sorted by a packed 64-bit key before execution,
+     * so that draws sharing a program, texture and VAO run back to back.
+     *
+     * The pass takes the top 4 bits. Opaque and overlay keys continue with
+     * the shader, texture and VAO IDs (12 bits each) and the depth (24 bits),
+     * so state changes come first and equal state is drawn front-to-back.
+     * Transparent keys put the inverted depth right after the pass, drawing
+     * back-to-front. IDs above 4095 share sort buckets but still draw
+     * correctly.
+     */
+    class RenderQueue
+    {
+      public:
+        /**
+         * Computes the sort key of a draw.
+         *
+         * @param pass The pass of the draw.
+         * @param command The draw command.
+         * @param depth The normalized view depth, from 0 (near) to 1 (far).
+         * @return The sort key.
+         */
+        static uint64_t makeKey(const kdr::gfx::RenderPass pass, const kdr::gfx::DrawCommand& command, const float depth);
+
+        /**
+         * Gets the number of queued commands.
+         *
+         * @return The number of commands.
+         */
+        size_t size() const
+        { return this->commands.size(); }
+
+        /**
+         * Queues a draw command.
+         *
+         * @param pass The pass of the draw.
+         * @param command The draw command.
+         * @param depth The normalized view depth, from 0 (near) to 1 (far).
+         */
+        void Submit(const kdr::gfx::RenderPass pass, const kdr::gfx::DrawCommand& command, const float depth);
+        /**
+         * Sorts the queued commands by key with an LSD radix sort.
+         */
+        void Sort();
+        /**
+         * Sorts the queued commands and issues them, binding through the state
+         * cache. Texture bindings use texture unit 0.
+         */
+        void Execute();
+        /**
+         * Removes all queued commands, keeping their storage.
+         */
+        void Clear();
+
+      private:
+        std::vector<kdr::gfx::DrawCommand> commands;
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> sortedKeys;
+        std::vector<uint32_t> order;
+        std::vector<uint64_t> scratchKeys;
+        std::vector<uint32_t> scratchOrder;
+    };
+  }
+}
+
+#endif // KDR_RENDER_QUEUE_HPP
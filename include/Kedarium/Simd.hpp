@@ -0,0 +1,50 @@
+#ifndef KDR_SIMD_HPP
+#define KDR_SIMD_HPP
+
+/**
+ * Compile-time selection of the SIMD instruction set used by the engine's
+ * vectorized kernels. Exactly one of KDR_SIMD_AVX, KDR_SIMD_SSE,
+ * KDR_SIMD_NEON or KDR_SIMD_SCALAR is defined. Define KDR_NO_SIMD to force
+ * the scalar fallback.
+ */
+#if defined(KDR_NO_SIMD)
+  #define KDR_SIMD_SCALAR
+#elif defined(__AVX__)
+  #define KDR_SIMD_AVX
+  #define KDR_SIMD_SSE
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define KDR_SIMD_SSE
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define KDR_SIMD_NEON
+  #include <arm_neon.h>
+#else
+  #define KDR_SIMD_SCALAR
+#endif
+
+namespace kdr
+{
+  namespace simd
+  {
+    /**
+     * Gets the name of the instruction set the engine was compiled for.
+     *
+     * @return "AVX", "SSE", "NEON" or "Scalar".
+     */
+    inline const char* getInstructionSet()
+    {
+#if defined(KDR_SIMD_AVX)
+      return "AVX";
+#elif defined(KDR_SIMD_SSE)
+      return "SSE";
+#elif defined(KDR_SIMD_NEON)
+      return "NEON";
+#else
+      return "Scalar";
+#endif
+    }
+  }
+}
+
+#endif // KDR_SIMD_HPP
@@ -2,7 +2,14 @@
 #define KDR_SPACE_HPP
 
 #include <math.h>
-#include <cstring>
+#include <cstddef>
+
+/**
+ * Evaluates to true when the enclosing constexpr function is being evaluated
+ * at compile time. Used to route constant evaluation to the scalar code and
+ * runtime calls to the SIMD kernels and the C math library.
+ */
+#define KDR_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 
 namespace kdr
 {
@@ -11,7 +18,13 @@ namespace kdr
     /**
      * Constant representing the mathematical constant PI.
      */
-    const float PI {3.141593f};
+    constexpr float PI {3.141593f};
+    /**
+     * Number of elements per thread in batched transforms. Larger batches are
+     * split across one thread per started BATCH_PARALLEL_THRESHOLD elements,
+     * up to the hardware thread count.
+     */
+    constexpr size_t BATCH_PARALLEL_THRESHOLD {65536};
 
     /**
      * Converts degrees to radians.
@@ -19,8 +32,211 @@ namespace kdr
      * @param degrees The angle in degrees to be converted.
      * @return The equivalent angle in radians.
      */
-    inline float radians(const float degrees)
-    { return degrees * 180 / kdr::space::PI; }
+    constexpr float radians(const float degrees)
+    { return degrees * kdr::space::PI / 180.f; }
+    /**
+     * Computes the square root of a value. Uses Newton's method at compile time
+     * and sqrtf at runtime.
+     *
+     * @param value The non-negative value.
+     * @return The square root of the value.
+     */
+    constexpr float sqrt(const float value)
+    {
+      if (!KDR_IS_CONSTANT_EVALUATED()) return sqrtf(value);
+      if (value <= 0.f) return 0.f;
+
+      double root = value > 1.f ? value : 1.0;
+      for (int i = 0; i < 128; i++)
+      {
+        const double next = 0.5 * (root + value / root);
+        if (next >= root) break;
+        root = next;
+      }
+      return (float)root;
+    }
+    /**
+     * Computes the sine of an angle. Uses a Taylor series at compile time
+     * and sinf at runtime.
+     *
+     * @param angle The angle in radians.
+     * @return The sine of the angle.
+     */
+    constexpr float sin(const float angle)
+    {
+      if (!KDR_IS_CONSTANT_EVALUATED()) return sinf(angle);
+
+      const double twoPI = 6.283185307179586;
+      const double turns = angle / twoPI;
+      const double x = angle - twoPI * (double)(long long)(turns + (turns >= 0 ? 0.5 : -0.5));
+      double term = x;
+      double sum  = x;
+      for (int i = 1; i < 13; i++)
+      {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum  += term;
+      }
+      return (float)sum;
+    }
+    /**
+     * Computes the cosine of an angle. Uses a Taylor series at compile time
+     * and cosf at runtime.
+     *
+     * @param angle The angle in radians.
+     * @return The cosine of the angle.
+     */
+    constexpr float cos(const float angle)
+    {
+      if (!KDR_IS_CONSTANT_EVALUATED()) return cosf(angle);
+
+      const double twoPI = 6.283185307179586;
+      const double turns = angle / twoPI;
+      const double x = angle - twoPI * (double)(long long)(turns + (turns >= 0 ? 0.5 : -0.5));
+      double term = 1.0;
+      double sum  = 1.0;
+      for (int i = 1; i < 13; i++)
+      {
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        sum  += term;
+      }
+      return (float)sum;
+    }
+    /**
+     * Computes the tangent of an angle.
+     *
+     * @param angle The angle in radians.
+     * @return The tangent of the angle.
+     */
+    constexpr float tan(const float angle)
+    {
+      if (!KDR_IS_CONSTANT_EVALUATED()) return tanf(angle);
+      return kdr::space::sin(angle) / kdr::space::cos(angle);
+    }
+
+    /**
+     * 2D vector class representing a point or direction in 2D space.
+     */
+    class Vec2
+    {
+      public:
+        float x {0.f};
+        float y {0.f};
+
+        /**
+         * Constructs a Vec2 with all components set to zero.
+         */
+        constexpr Vec2()
+        {}
+        /**
+         * Constructs a Vec2 with specified x and y components.
+         *
+         * @param x The x-component of the vector.
+         * @param y The y-component of the vector.
+         */
+        constexpr Vec2(const float x, const float y)
+        : x(x), y(y)
+        {}
+        /**
+         * Constructs a Vec2 with all components set to the same scalar value.
+         *
+         * @param scalar The scalar value to set for all components.
+         */
+        constexpr Vec2(const float scalar)
+        : x(scalar), y(scalar)
+        {}
+
+        /**
+         * Overloaded addition operator for Vec2.
+         *
+         * @param vec The vector to add.
+         * @return A new Vec2 representing the sum of the two vectors.
+         */
+        constexpr Vec2 operator+(const Vec2& vec) const
+        { return Vec2(this->x + vec.x, this->y + vec.y); }
+        /**
+         * Overloaded subtraction operator for Vec2.
+         *
+         * @param vec The vector to subtract.
+         * @return A new Vec2 representing the difference between the two vectors.
+         */
+        constexpr Vec2 operator-(const Vec2& vec) const
+        { return Vec2(this->x - vec.x, this->y - vec.y); }
+        /**
+         * Negates the vector.
+         *
+         * @return A new Vec2 pointing in the opposite direction.
+         */
+        constexpr Vec2 operator-() const
+        { return Vec2(-this->x, -this->y); }
+        /**
+         * Multiplies a 2D vector by a scalar.
+         *
+         * @param scalar The scalar value to multiply the vector by.
+         * @return The resulting vector after multiplication.
+         */
+        constexpr Vec2 operator*(const float scalar) const
+        { return Vec2(this->x * scalar, this->y * scalar); }
+        /**
+         * Divides a 2D vector by a scalar.
+         *
+         * @param scalar The scalar value to divide the vector by.
+         * @return The resulting vector after division.
+         */
+        constexpr Vec2 operator/(const float scalar) const
+        { return Vec2(this->x / scalar, this->y / scalar); }
+        /**
+         * Adds another 2D vector to the current vector in-place.
+         *
+         * @param vec The vector to be added.
+         * @return Reference to the modified current vector.
+         */
+        constexpr Vec2& operator+=(const Vec2& vec)
+        {
+          this->x += vec.x;
+          this->y += vec.y;
+          return *this;
+        }
+        /**
+         * Subtracts another 2D vector from the current vector in-place.
+         *
+         * @param vec The vector to be subtracted.
+         * @return Reference to the modified current vector.
+         */
+        constexpr Vec2& operator-=(const Vec2& vec)
+        {
+          this->x -= vec.x;
+          this->y -= vec.y;
+          return *this;
+        }
+        /**
+         * Multiplies the current vector by a scalar in-place.
+         *
+         * @param scalar The scalar value to multiply the vector by.
+         * @return Reference to the modified current vector.
+         */
+        constexpr Vec2& operator*=(const float scalar)
+        {
+          this->x *= scalar;
+          this->y *= scalar;
+          return *this;
+        }
+        /**
+         * Compares two 2D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if all components are equal, false otherwise.
+         */
+        constexpr bool operator==(const Vec2& vec) const
+        { return this->x == vec.x && this->y == vec.y; }
+        /**
+         * Compares two 2D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if any component differs, false otherwise.
+         */
+        constexpr bool operator!=(const Vec2& vec) const
+        { return !(*this == vec); }
+    };
 
     /**
      * 3D vector class representing a point or direction in 3D space.
@@ -32,6 +248,11 @@ namespace kdr
         float y {0.f};
         float z {0.f};
 
+        /**
+         * Constructs a Vec3 with all components set to zero.
+         */
+        constexpr Vec3()
+        {}
         /**
          * Constructs a Vec3 with specified x, y, and z components.
          *
@@ -39,7 +260,7 @@ namespace kdr
          * @param y The y-component of the vector.
          * @param z The z-component of the vector.
          */
-        Vec3(const float x, const float y, const float z)
+        constexpr Vec3(const float x, const float y, const float z)
         : x(x), y(y), z(z)
         {}
         /**
@@ -47,7 +268,7 @@ namespace kdr
          *
          * @param scalar The scalar value to set for all components.
          */
-        Vec3(const float scalar)
+        constexpr Vec3(const float scalar)
         : x(scalar), y(scalar), z(scalar)
         {}
 
@@ -57,7 +278,7 @@ namespace kdr
          * @param vec The vector to add.
          * @return A new Vec3 representing the sum of the two vectors.
          */
-        Vec3 operator+(const Vec3& vec)
+        constexpr Vec3 operator+(const Vec3& vec) const
         {
           return Vec3(
             this->x + vec.x,
@@ -71,7 +292,7 @@ namespace kdr
          * @param vec The vector to subtract.
          * @return A new Vec3 representing the difference between the two vectors.
          */
-        Vec3 operator-(const Vec3& vec)
+        constexpr Vec3 operator-(const Vec3& vec) const
         {
           return Vec3(
             this->x - vec.x,
@@ -79,13 +300,20 @@ namespace kdr
             this->z - vec.z
           );
         }
+        /**
+         * Negates the vector.
+         *
+         * @return A new Vec3 pointing in the opposite direction.
+         */
+        constexpr Vec3 operator-() const
+        { return Vec3(-this->x, -this->y, -this->z); }
         /**
          * Multiplies a 3D vector by a scalar.
          *
          * @param scalar The scalar value to multiply the vector by.
          * @return The resulting vector after multiplication.
          */
-        Vec3 operator*(float scalar)
+        constexpr Vec3 operator*(const float scalar) const
         {
           return Vec3(
             this->x * scalar,
@@ -93,13 +321,27 @@ namespace kdr
             this->z * scalar
           );
         }
+        /**
+         * Divides a 3D vector by a scalar.
+         *
+         * @param scalar The scalar value to divide the vector by.
+         * @return The resulting vector after division.
+         */
+        constexpr Vec3 operator/(const float scalar) const
+        {
+          return Vec3(
+            this->x / scalar,
+            this->y / scalar,
+            this->z / scalar
+          );
+        }
         /**
          * Adds another 3D vector to the current vector in-place.
          *
          * @param vec The vector to be added.
          * @return Reference to the modified current vector.
          */
-        Vec3& operator+=(const Vec3& vec)
+        constexpr Vec3& operator+=(const Vec3& vec)
         {
           this->x += vec.x;
           this->y += vec.y;
@@ -112,57 +354,382 @@ namespace kdr
          * @param vec The vector to be subtracted.
          * @return Reference to the modified current vector.
          */
-        Vec3& operator-=(const Vec3& vec)
+        constexpr Vec3& operator-=(const Vec3& vec)
         {
           this->x -= vec.x;
           this->y -= vec.y;
           this->z -= vec.z;
           return *this;
         }
+        /**
+         * Multiplies the current vector by a scalar in-place.
+         *
+         * @param scalar The scalar value to multiply the vector by.
+         * @return Reference to the modified current vector.
+         */
+        constexpr Vec3& operator*=(const float scalar)
+        {
+          this->x *= scalar;
+          this->y *= scalar;
+          this->z *= scalar;
+          return *this;
+        }
+        /**
+         * Compares two 3D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if all components are equal, false otherwise.
+         */
+        constexpr bool operator==(const Vec3& vec) const
+        { return this->x == vec.x && this->y == vec.y && this->z == vec.z; }
+        /**
+         * Compares two 3D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if any component differs, false otherwise.
+         */
+        constexpr bool operator!=(const Vec3& vec) const
+        { return !(*this == vec); }
     };
 
     /**
-     * 4x4 matrix class for representing transformations in 3D space.
+     * 4D vector class representing a homogeneous point or direction.
+     * Aligned to 16 bytes so it can be loaded directly into a SIMD register.
      */
-    class Mat4
+    class alignas(16) Vec4
     {
       public:
+        float x {0.f};
+        float y {0.f};
+        float z {0.f};
+        float w {0.f};
+
         /**
-         * Default constructor. Initializes the matrix to the zero matrix.
+         * Constructs a Vec4 with all components set to zero.
+         */
+        constexpr Vec4()
+        {}
+        /**
+         * Constructs a Vec4 with specified x, y, z, and w components.
+         *
+         * @param x The x-component of the vector.
+         * @param y The y-component of the vector.
+         * @param z The z-component of the vector.
+         * @param w The w-component of the vector.
+         */
+        constexpr Vec4(const float x, const float y, const float z, const float w)
+        : x(x), y(y), z(z), w(w)
+        {}
+        /**
+         * Constructs a Vec4 from a Vec3 and a w component.
+         *
+         * @param vec The vector providing the x, y, and z components.
+         * @param w The w-component of the vector.
+         */
+        constexpr Vec4(const kdr::space::Vec3& vec, const float w)
+        : x(vec.x), y(vec.y), z(vec.z), w(w)
+        {}
+        /**
+         * Constructs a Vec4 with all components set to the same scalar value.
+         *
+         * @param scalar The scalar value to set for all components.
+         */
+        constexpr Vec4(const float scalar)
+        : x(scalar), y(scalar), z(scalar), w(scalar)
+        {}
+
+        /**
+         * Overloaded addition operator for Vec4.
+         *
+         * @param vec The vector to add.
+         * @return A new Vec4 representing the sum of the two vectors.
+         */
+        constexpr Vec4 operator+(const Vec4& vec) const
+        {
+          return Vec4(
+            this->x + vec.x,
+            this->y + vec.y,
+            this->z + vec.z,
+            this->w + vec.w
+          );
+        }
+        /**
+         * Overloaded subtraction operator for Vec4.
+         *
+         * @param vec The vector to subtract.
+         * @return A new Vec4 representing the difference between the two vectors.
          */
-        Mat4()
+        constexpr Vec4 operator-(const Vec4& vec) const
         {
-          memset(this->elements, 0.f, sizeof(this->elements));
+          return Vec4(
+            this->x - vec.x,
+            this->y - vec.y,
+            this->z - vec.z,
+            this->w - vec.w
+          );
         }
+        /**
+         * Multiplies a 4D vector by a scalar.
+         *
+         * @param scalar The scalar value to multiply the vector by.
+         * @return The resulting vector after multiplication.
+         */
+        constexpr Vec4 operator*(const float scalar) const
+        {
+          return Vec4(
+            this->x * scalar,
+            this->y * scalar,
+            this->z * scalar,
+            this->w * scalar
+          );
+        }
+        /**
+         * Compares two 4D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if all components are equal, false otherwise.
+         */
+        constexpr bool operator==(const Vec4& vec) const
+        { return this->x == vec.x && this->y == vec.y && this->z == vec.z && this->w == vec.w; }
+        /**
+         * Compares two 4D vectors component-wise.
+         *
+         * @param vec The vector to compare with.
+         * @return True if any component differs, false otherwise.
+         */
+        constexpr bool operator!=(const Vec4& vec) const
+        { return !(*this == vec); }
+    };
+
+    /**
+     * Quaternion class representing a rotation in 3D space.
+     */
+    class Quat
+    {
+      public:
+        float x {0.f};
+        float y {0.f};
+        float z {0.f};
+        float w {1.f};
+
+        /**
+         * Constructs the identity quaternion.
+         */
+        constexpr Quat()
+        {}
+        /**
+         * Constructs a Quat with specified x, y, z, and w components.
+         *
+         * @param x The x-component of the vector part.
+         * @param y The y-component of the vector part.
+         * @param z The z-component of the vector part.
+         * @param w The scalar part.
+         */
+        constexpr Quat(const float x, const float y, const float z, const float w)
+        : x(x), y(y), z(z), w(w)
+        {}
+
+        /**
+         * Overloaded multiplication operator for composing rotations.
+         *
+         * @param quat The quaternion to be multiplied with.
+         * @return The rotation applying quat first, then this quaternion.
+         */
+        constexpr Quat operator*(const Quat& quat) const
+        {
+          return Quat(
+            this->w * quat.x + this->x * quat.w + this->y * quat.z - this->z * quat.y,
+            this->w * quat.y - this->x * quat.z + this->y * quat.w + this->z * quat.x,
+            this->w * quat.z + this->x * quat.y - this->y * quat.x + this->z * quat.w,
+            this->w * quat.w - this->x * quat.x - this->y * quat.y - this->z * quat.z
+          );
+        }
+        /**
+         * Compares two quaternions component-wise.
+         *
+         * @param quat The quaternion to compare with.
+         * @return True if all components are equal, false otherwise.
+         */
+        constexpr bool operator==(const Quat& quat) const
+        { return this->x == quat.x && this->y == quat.y && this->z == quat.z && this->w == quat.w; }
+        /**
+         * Compares two quaternions component-wise.
+         *
+         * @param quat The quaternion to compare with.
+         * @return True if any component differs, false otherwise.
+         */
+        constexpr bool operator!=(const Quat& quat) const
+        { return !(*this == quat); }
+    };
+
+    /**
+     * 3x3 matrix class for representing rotations and scales in 3D space.
+     * Elements are stored column by column.
+     */
+    class Mat3
+    {
+      public:
+        /**
+         * Default constructor. Initializes the matrix to the zero matrix.
+         */
+        constexpr Mat3()
+        : elements{}
+        {}
         /**
          * Constructs a diagonal matrix with the specified diagonal number.
          *
          * @param diagonalNumber The value to set on the diagonal elements.
          */
-        Mat4(const float diagonalNumber)
+        constexpr Mat3(const float diagonalNumber)
+        : elements{
+            {diagonalNumber, 0.f, 0.f},
+            {0.f, diagonalNumber, 0.f},
+            {0.f, 0.f, diagonalNumber}
+          }
+        {}
+        /**
+         * Constructs a matrix from three column vectors.
+         *
+         * @param col0 The first column.
+         * @param col1 The second column.
+         * @param col2 The third column.
+         */
+        constexpr Mat3(const kdr::space::Vec3& col0, const kdr::space::Vec3& col1, const kdr::space::Vec3& col2)
+        : elements{
+            {col0.x, col0.y, col0.z},
+            {col1.x, col1.y, col1.z},
+            {col2.x, col2.y, col2.z}
+          }
+        {}
+
+        /**
+         * Overloaded indexing operator for accessing matrix elements.
+         *
+         * @param i The column index.
+         * @return A pointer to the specified column of matrix elements.
+         */
+        constexpr float* operator[](int i)
+        { return this->elements[i]; }
+        /**
+         * Overloaded const indexing operator for accessing matrix elements.
+         *
+         * @param i The column index.
+         * @return A const pointer to the specified column of matrix elements.
+         */
+        constexpr const float* operator[](int i) const
+        { return this->elements[i]; }
+        /**
+         * Overloaded multiplication operator for matrix multiplication.
+         *
+         * @param mat The matrix to be multiplied with.
+         * @return The result of the matrix multiplication.
+         */
+        constexpr Mat3 operator*(const Mat3& mat) const
         {
-          memset(this->elements, 0.f, sizeof(this->elements));
-          for (int i = 0; i < 4; i++)
+          Mat3 result;
+          for (int i = 0; i < 3; i++)
           {
-            this->elements[i][i] = diagonalNumber;
+            for (int j = 0; j < 3; j++)
+            {
+              float sum = this->elements[0][j] * mat[i][0];
+              sum += this->elements[1][j] * mat[i][1];
+              sum += this->elements[2][j] * mat[i][2];
+              result[i][j] = sum;
+            }
+          }
+          return result;
+        }
+        /**
+         * Overloaded multiplication operator for transforming a 3D vector.
+         *
+         * @param vec The vector to be transformed.
+         * @return The transformed vector.
+         */
+        constexpr kdr::space::Vec3 operator*(const kdr::space::Vec3& vec) const
+        {
+          return kdr::space::Vec3(
+            this->elements[0][0] * vec.x + this->elements[1][0] * vec.y + this->elements[2][0] * vec.z,
+            this->elements[0][1] * vec.x + this->elements[1][1] * vec.y + this->elements[2][1] * vec.z,
+            this->elements[0][2] * vec.x + this->elements[1][2] * vec.y + this->elements[2][2] * vec.z
+          );
+        }
+        /**
+         * Compares two matrices element-wise.
+         *
+         * @param mat The matrix to compare with.
+         * @return True if all elements are equal, false otherwise.
+         */
+        constexpr bool operator==(const Mat3& mat) const
+        {
+          for (int i = 0; i < 3; i++)
+          {
+            for (int j = 0; j < 3; j++)
+            {
+              if (this->elements[i][j] != mat[i][j]) return false;
+            }
           }
+          return true;
         }
 
+      private:
+        float elements[3][3];
+    };
+
+    /**
+     * 4x4 matrix class for representing transformations in 3D space.
+     * Elements are stored column by column in 16-byte aligned memory.
+     */
+    class alignas(16) Mat4
+    {
+      public:
+        /**
+         * Default constructor. Initializes the matrix to the zero matrix.
+         */
+        constexpr Mat4()
+        : elements{}
+        {}
+        /**
+         * Constructs a diagonal matrix with the specified diagonal number.
+         *
+         * @param diagonalNumber The value to set on the diagonal elements.
+         */
+        constexpr Mat4(const float diagonalNumber)
+        : elements{
+            {diagonalNumber, 0.f, 0.f, 0.f},
+            {0.f, diagonalNumber, 0.f, 0.f},
+            {0.f, 0.f, diagonalNumber, 0.f},
+            {0.f, 0.f, 0.f, diagonalNumber}
+          }
+        {}
+        /**
+         * Constructs a 4x4 matrix from a 3x3 matrix, with 1 on the last diagonal element.
+         *
+         * @param mat The 3x3 matrix to be placed in the upper-left corner.
+         */
+        explicit constexpr Mat4(const kdr::space::Mat3& mat)
+        : elements{
+            {mat[0][0], mat[0][1], mat[0][2], 0.f},
+            {mat[1][0], mat[1][1], mat[1][2], 0.f},
+            {mat[2][0], mat[2][1], mat[2][2], 0.f},
+            {0.f, 0.f, 0.f, 1.f}
+          }
+        {}
+
         /**
          * Overloaded indexing operator for accessing matrix elements.
          *
-         * @param i The row index.
-         * @return A pointer to the specified row of matrix elements.
+         * @param i The column index.
+         * @return A pointer to the specified column of matrix elements.
          */
-        float* operator[](int i)
+        constexpr float* operator[](int i)
         { return this->elements[i]; }
         /**
          * Overloaded const indexing operator for accessing matrix elements.
          *
-         * @param i The row index.
-         * @return A const pointer to the specified row of matrix elements.
+         * @param i The column index.
+         * @return A const pointer to the specified column of matrix elements.
          */
-        const float* operator[](int i) const
+        constexpr const float* operator[](int i) const
         { return this->elements[i]; }
         /**
          * Overloaded multiplication operator for matrix multiplication.
@@ -170,23 +737,45 @@ namespace kdr
          * @param mat The matrix to be multiplied with.
          * @return The result of the matrix multiplication.
          */
-        Mat4 operator*(const Mat4& mat)
+        constexpr Mat4 operator*(const Mat4& mat) const;
+        /**
+         * Overloaded multiplication operator for transforming a 4D vector.
+         *
+         * @param vec The vector to be transformed.
+         * @return The transformed vector.
+         */
+        constexpr kdr::space::Vec4 operator*(const kdr::space::Vec4& vec) const;
+        /**
+         * Compares two matrices element-wise.
+         *
+         * @param mat The matrix to compare with.
+         * @return True if all elements are equal, false otherwise.
+         */
+        constexpr bool operator==(const Mat4& mat) const
         {
-          Mat4 result;
-          for (int i = 0; i < 4; i++) {
-            for (int j = 0; j < 4; j++) {
-              for (int k = 0; k < 4; k++) {
-                result[i][j] += mat[i][k] * elements[k][j];
-              }
+          for (int i = 0; i < 4; i++)
+          {
+            for (int j = 0; j < 4; j++)
+            {
+              if (this->elements[i][j] != mat[i][j]) return false;
             }
           }
-          return result;
+          return true;
         }
 
       private:
-        float elements[4][4];
+        alignas(16) float elements[4][4];
     };
 
+    /**
+     * Computes the dot product of two 2D vectors.
+     *
+     * @param vecA The first 2D vector.
+     * @param vecB The second 2D vector.
+     * @return The dot product of the two vectors.
+     */
+    constexpr float dot(const kdr::space::Vec2& vecA, const kdr::space::Vec2& vecB)
+    { return vecA.x * vecB.x + vecA.y * vecB.y; }
     /**
      * Computes the dot product of two 3D vectors.
      *
@@ -194,8 +783,17 @@ namespace kdr
      * @param vecB The second 3D vector.
      * @return The dot product of the two vectors.
      */
-    inline float dot(const kdr::space::Vec3& vecA, const kdr::space::Vec3& vecB)
+    constexpr float dot(const kdr::space::Vec3& vecA, const kdr::space::Vec3& vecB)
     { return vecA.x * vecB.x + vecA.y * vecB.y + vecA.z * vecB.z; }
+    /**
+     * Computes the dot product of two 4D vectors.
+     *
+     * @param vecA The first 4D vector.
+     * @param vecB The second 4D vector.
+     * @return The dot product of the two vectors.
+     */
+    constexpr float dot(const kdr::space::Vec4& vecA, const kdr::space::Vec4& vecB)
+    { return vecA.x * vecB.x + vecA.y * vecB.y + vecA.z * vecB.z + vecA.w * vecB.w; }
     /**
      * Computes the cross product of two 3D vectors.
      *
@@ -203,7 +801,7 @@ namespace kdr
      * @param vecB The second 3D vector.
      * @return The cross product of the two vectors.
      */
-    inline kdr::space::Vec3 cross(const kdr::space::Vec3& vecA, const kdr::space::Vec3& vecB)
+    constexpr kdr::space::Vec3 cross(const kdr::space::Vec3& vecA, const kdr::space::Vec3& vecB)
     {
       return kdr::space::Vec3 {
         vecA.y * vecB.z - vecA.z * vecB.y,
@@ -211,7 +809,139 @@ namespace kdr
         vecA.x * vecB.y - vecA.y * vecB.x
       };
     }
+    /**
+     * Computes the length of a 3D vector.
+     *
+     * @param vec The 3D vector.
+     * @return The Euclidean length of the vector.
+     */
+    constexpr float length(const kdr::space::Vec3& vec)
+    { return kdr::space::sqrt(kdr::space::dot(vec, vec)); }
+    /**
+     * Normalizes a 3D vector.
+     *
+     * @param vec The 3D vector to be normalized.
+     * @return The vector scaled to unit length.
+     */
+    constexpr kdr::space::Vec3 normalize(const kdr::space::Vec3& vec)
+    { return vec / kdr::space::length(vec); }
 
+    /**
+     * Computes the conjugate of a quaternion.
+     *
+     * @param quat The quaternion.
+     * @return The conjugate, which is the inverse rotation for unit quaternions.
+     */
+    constexpr kdr::space::Quat conjugate(const kdr::space::Quat& quat)
+    { return kdr::space::Quat {-quat.x, -quat.y, -quat.z, quat.w}; }
+    /**
+     * Normalizes a quaternion.
+     *
+     * @param quat The quaternion to be normalized.
+     * @return The quaternion scaled to unit length.
+     */
+    constexpr kdr::space::Quat normalize(const kdr::space::Quat& quat)
+    {
+      const float len = kdr::space::sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z + quat.w * quat.w);
+      return kdr::space::Quat {quat.x / len, quat.y / len, quat.z / len, quat.w / len};
+    }
+    /**
+     * Creates a quaternion rotating around an axis.
+     *
+     * @param angle The rotation angle in degrees.
+     * @param axis The rotation axis.
+     * @return The resulting unit quaternion.
+     */
+    constexpr kdr::space::Quat angleAxis(const float angle, const kdr::space::Vec3& axis)
+    {
+      const float halfAngle = kdr::space::radians(angle) / 2.f;
+      const kdr::space::Vec3 unitAxis = kdr::space::normalize(axis) * kdr::space::sin(halfAngle);
+      return kdr::space::Quat {unitAxis.x, unitAxis.y, unitAxis.z, kdr::space::cos(halfAngle)};
+    }
+    /**
+     * Rotates a 3D vector by a unit quaternion.
+     *
+     * @param quat The rotation.
+     * @param vec The vector to be rotated.
+     * @return The rotated vector.
+     */
+    constexpr kdr::space::Vec3 rotate(const kdr::space::Quat& quat, const kdr::space::Vec3& vec)
+    {
+      const kdr::space::Vec3 axis {quat.x, quat.y, quat.z};
+      const kdr::space::Vec3 uv  = kdr::space::cross(axis, vec);
+      const kdr::space::Vec3 uuv = kdr::space::cross(axis, uv);
+      return vec + (uv * quat.w + uuv) * 2.f;
+    }
+    /**
+     * Converts a unit quaternion to a rotation matrix.
+     *
+     * @param quat The rotation.
+     * @return The equivalent 3x3 rotation matrix.
+     */
+    constexpr kdr::space::Mat3 toMat3(const kdr::space::Quat& quat)
+    {
+      const float xx = quat.x * quat.x, yy = quat.y * quat.y, zz = quat.z * quat.z;
+      const float xy = quat.x * quat.y, xz = quat.x * quat.z, yz = quat.y * quat.z;
+      const float wx = quat.w * quat.x, wy = quat.w * quat.y, wz = quat.w * quat.z;
+      return kdr::space::Mat3 {
+        {1.f - 2.f * (yy + zz), 2.f * (xy + wz), 2.f * (xz - wy)},
+        {2.f * (xy - wz), 1.f - 2.f * (xx + zz), 2.f * (yz + wx)},
+        {2.f * (xz + wy), 2.f * (yz - wx), 1.f - 2.f * (xx + yy)}
+      };
+    }
+    /**
+     * Converts a unit quaternion to a 4x4 rotation matrix.
+     *
+     * @param quat The rotation.
+     * @return The equivalent 4x4 rotation matrix.
+     */
+    constexpr kdr::space::Mat4 toMat4(const kdr::space::Quat& quat)
+    { return kdr::space::Mat4 {kdr::space::toMat3(quat)}; }
+
+    /**
+     * Transposes a 3x3 matrix.
+     *
+     * @param mat The matrix to be transposed.
+     * @return The transposed matrix.
+     */
+    constexpr kdr::space::Mat3 transpose(const kdr::space::Mat3& mat)
+    {
+      kdr::space::Mat3 result;
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = 0; j < 3; j++)
+        {
+          result[i][j] = mat[j][i];
+        }
+      }
+      return result;
+    }
+    /**
+     * Transposes a 4x4 matrix.
+     *
+     * @param mat The matrix to be transposed.
+     * @return The transposed matrix.
+     */
+    constexpr kdr::space::Mat4 transpose(const kdr::space::Mat4& mat)
+    {
+      kdr::space::Mat4 result;
+      for (int i = 0; i < 4; i++)
+      {
+        for (int j = 0; j < 4; j++)
+        {
+          result[i][j] = mat[j][i];
+        }
+      }
+      return result;
+    }
+    /**
+     * Gets a pointer to the first element of the matrix data.
+     *
+     * @param mat The matrix for which the pointer is obtained.
+     * @return A pointer to the first element of the matrix data.
+     */
+    inline const float* valuePointer(const kdr::space::Mat3& mat)
+    { return &mat[0][0]; }
     /**
      * Gets a pointer to the first element of the matrix data.
      *
@@ -220,6 +950,129 @@ namespace kdr
      */
     inline const float* valuePointer(const kdr::space::Mat4& mat)
     { return &mat[0][0]; }
+
+    /**
+     * Scalar reference implementations of the SIMD kernels. The vectorized
+     * versions perform the same operations in the same order and produce
+     * bit-for-bit identical results. Constant evaluation always uses these.
+     */
+    namespace scalar
+    {
+      /**
+       * Multiplies two 4x4 matrices.
+       *
+       * @param matA The left-hand matrix.
+       * @param matB The right-hand matrix.
+       * @return The product matA * matB.
+       */
+      constexpr kdr::space::Mat4 multiply(const kdr::space::Mat4& matA, const kdr::space::Mat4& matB)
+      {
+        kdr::space::Mat4 result;
+        for (int i = 0; i < 4; i++)
+        {
+          for (int j = 0; j < 4; j++)
+          {
+            float sum = matA[0][j] * matB[i][0];
+            sum += matA[1][j] * matB[i][1];
+            sum += matA[2][j] * matB[i][2];
+            sum += matA[3][j] * matB[i][3];
+            result[i][j] = sum;
+          }
+        }
+        return result;
+      }
+      /**
+       * Transforms a 4D vector by a 4x4 matrix.
+       *
+       * @param mat The transformation matrix.
+       * @param vec The vector to be transformed.
+       * @return The product mat * vec.
+       */
+      constexpr kdr::space::Vec4 transform(const kdr::space::Mat4& mat, const kdr::space::Vec4& vec)
+      {
+        float result[4] {};
+        for (int j = 0; j < 4; j++)
+        {
+          float sum = mat[0][j] * vec.x;
+          sum += mat[1][j] * vec.y;
+          sum += mat[2][j] * vec.z;
+          sum += mat[3][j] * vec.w;
+          result[j] = sum;
+        }
+        return kdr::space::Vec4 {result[0], result[1], result[2], result[3]};
+      }
+      /**
+       * Translates a 4x4 matrix by a 3D vector.
+       *
+       * @param mat The input 4x4 matrix.
+       * @param vec The translation vector.
+       * @return The resulting translated matrix.
+       */
+      constexpr kdr::space::Mat4 translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec)
+      {
+        kdr::space::Mat4 result {mat};
+        result[3][0] += vec.x;
+        result[3][1] += vec.y;
+        result[3][2] += vec.z;
+        return result;
+      }
+    }
+
+    /**
+     * SIMD kernels selected at compile time (see Simd.hpp).
+     */
+    namespace simd
+    {
+      /**
+       * Multiplies two 4x4 matrices.
+       *
+       * @param matA The left-hand matrix.
+       * @param matB The right-hand matrix.
+       * @return The product matA * matB.
+       */
+      kdr::space::Mat4 multiply(const kdr::space::Mat4& matA, const kdr::space::Mat4& matB);
+      /**
+       * Transforms a 4D vector by a 4x4 matrix.
+       *
+       * @param mat The transformation matrix.
+       * @param vec The vector to be transformed.
+       * @return The product mat * vec.
+       */
+      kdr::space::Vec4 transform(const kdr::space::Mat4& mat, const kdr::space::Vec4& vec);
+      /**
+       * Translates a 4x4 matrix by a 3D vector.
+       *
+       * @param mat The input 4x4 matrix.
+       * @param vec The translation vector.
+       * @return The resulting translated matrix.
+       */
+      kdr::space::Mat4 translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec);
+    }
+
+    /**
+     * Multiplies two 4x4 matrices.
+     *
+     * @param matA The left-hand matrix.
+     * @param matB The right-hand matrix.
+     * @return The product matA * matB.
+     */
+    constexpr kdr::space::Mat4 multiply(const kdr::space::Mat4& matA, const kdr::space::Mat4& matB)
+    {
+      if (KDR_IS_CONSTANT_EVALUATED()) return kdr::space::scalar::multiply(matA, matB);
+      return kdr::space::simd::multiply(matA, matB);
+    }
+    /**
+     * Transforms a 4D vector by a 4x4 matrix.
+     *
+     * @param mat The transformation matrix.
+     * @param vec The vector to be transformed.
+     * @return The product mat * vec.
+     */
+    constexpr kdr::space::Vec4 transform(const kdr::space::Mat4& mat, const kdr::space::Vec4& vec)
+    {
+      if (KDR_IS_CONSTANT_EVALUATED()) return kdr::space::scalar::transform(mat, vec);
+      return kdr::space::simd::transform(mat, vec);
+    }
     /**
      * Translates a 4x4 matrix by a 3D vector.
      *
@@ -227,7 +1080,11 @@ namespace kdr
      * @param vec The translation vector.
      * @return The resulting translated matrix.
      */
-    kdr::space::Mat4 translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec);
+    constexpr kdr::space::Mat4 translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec)
+    {
+      if (KDR_IS_CONSTANT_EVALUATED()) return kdr::space::scalar::translate(mat, vec);
+      return kdr::space::simd::translate(mat, vec);
+    }
     /**
      * Creates a perspective projection matrix.
      *
@@ -237,8 +1094,142 @@ namespace kdr
      * @param far The distance to the far clipping plane.
      * @return The resulting perspective projection matrix.
      */
-    kdr::space::Mat4 perspective(const float fov, const float aspect, const float near, const float far);
+    constexpr kdr::space::Mat4 perspective(const float fov, const float aspect, const float near, const float far)
+    {
+      kdr::space::Mat4 result;
+      const float halfTanFOV = kdr::space::tan(kdr::space::radians(fov) / 2.f);
+
+      result[0][0] = 1.f / (halfTanFOV * aspect);
+      result[1][1] = 1.f / halfTanFOV;
+      result[2][2] = (far + near) / (near - far);
+      result[2][3] = -1.f;
+      result[3][2] = -(2.f * far * near) / (far - near);
+
+      return result;
+    }
+    /**
+     * Creates an orthographic projection matrix.
+     *
+     * @param left The left clipping plane.
+     * @param right The right clipping plane.
+     * @param bottom The bottom clipping plane.
+     * @param top The top clipping plane.
+     * @param near The distance to the near clipping plane.
+     * @param far The distance to the far clipping plane.
+     * @return The resulting orthographic projection matrix.
+     */
+    constexpr kdr::space::Mat4 ortho(
+      const float left,
+      const float right,
+      const float bottom,
+      const float top,
+      const float near,
+      const float far
+    )
+    {
+      kdr::space::Mat4 result {1.f};
+
+      result[0][0] = 2.f / (right - left);
+      result[1][1] = 2.f / (top - bottom);
+      result[2][2] = -2.f / (far - near);
+      result[3][0] = -(right + left) / (right - left);
+      result[3][1] = -(top + bottom) / (top - bottom);
+      result[3][2] = -(far + near) / (far - near);
+
+      return result;
+    }
+    /**
+     * Creates a view matrix looking from a point towards a target.
+     *
+     * @param eye The position of the viewer.
+     * @param target The point being looked at.
+     * @param up The up direction of the viewer.
+     * @return The resulting view matrix.
+     */
+    constexpr kdr::space::Mat4 lookAt(const kdr::space::Vec3& eye, const kdr::space::Vec3& target, const kdr::space::Vec3& up)
+    {
+      const kdr::space::Vec3 front = kdr::space::normalize(target - eye);
+      const kdr::space::Vec3 side  = kdr::space::normalize(kdr::space::cross(front, up));
+      const kdr::space::Vec3 upper = kdr::space::cross(side, front);
+      kdr::space::Mat4 result {1.f};
+
+      result[0][0] =  side.x;
+      result[1][0] =  side.y;
+      result[2][0] =  side.z;
+      result[0][1] =  upper.x;
+      result[1][1] =  upper.y;
+      result[2][1] =  upper.z;
+      result[0][2] = -front.x;
+      result[1][2] = -front.y;
+      result[2][2] = -front.z;
+      result[3][0] = -kdr::space::dot(side, eye);
+      result[3][1] = -kdr::space::dot(upper, eye);
+      result[3][2] =  kdr::space::dot(front, eye);
+
+      return result;
+    }
+
+    /**
+     * Transforms a batch of points stored as separate x, y, and z arrays (w = 1).
+     * Batches of more than BATCH_PARALLEL_THRESHOLD points are split across a
+     * persistent pool of worker threads, started by the first such batch.
+     * The output arrays may alias the input arrays.
+     *
+     * @param mat The transformation matrix.
+     * @param xs The x-components of the points.
+     * @param ys The y-components of the points.
+     * @param zs The z-components of the points.
+     * @param outXs The array receiving the transformed x-components.
+     * @param outYs The array receiving the transformed y-components.
+     * @param outZs The array receiving the transformed z-components.
+     * @param count The number of points.
+     */
+    void transformPoints(
+      const kdr::space::Mat4& mat,
+      const float* xs,
+      const float* ys,
+      const float* zs,
+      float* outXs,
+      float* outYs,
+      float* outZs,
+      const size_t count
+    );
+    /**
+     * Transforms a batch of directions stored as separate x, y, and z arrays (w = 0).
+     * Batches of more than BATCH_PARALLEL_THRESHOLD directions are split across a
+     * persistent pool of worker threads, started by the first such batch.
+     * The output arrays may alias the input arrays.
+     *
+     * @param mat The transformation matrix.
+     * @param xs The x-components of the directions.
+     * @param ys The y-components of the directions.
+     * @param zs The z-components of the directions.
+     * @param outXs The array receiving the transformed x-components.
+     * @param outYs The array receiving the transformed y-components.
+     * @param outZs The array receiving the transformed z-components.
+     * @param count The number of directions.
+     */
+    void transformDirections(
+      const kdr::space::Mat4& mat,
+      const float* xs,
+      const float* ys,
+      const float* zs,
+      float* outXs,
+      float* outYs,
+      float* outZs,
+      const size_t count
+    );
   }
 }
 
+constexpr kdr::space::Mat4 kdr::space::Mat4::operator*(const kdr::space::Mat4& mat) const
+{
+  return kdr::space::multiply(*this, mat);
+}
+
+constexpr kdr::space::Vec4 kdr::space::Mat4::operator*(const kdr::space::Vec4& vec) const
+{
+  return kdr::space::transform(*this, vec);
+}
+
 #endif // KDR_SPACE_HPP
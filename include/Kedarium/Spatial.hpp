@@ -0,0 +1,197 @@
+#ifndef KDR_SPATIAL_HPP
+#define KDR_SPATIAL_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "Space.hpp"
+#include "Culling.hpp"
+
+namespace kdr
+{
+  namespace space
+  {
+    /**
+     * Ray described by an origin and a direction.
+     */
+    struct Ray
+    {
+      kdr::space::Vec3 origin;
+      kdr::space::Vec3 direction;
+    };
+
+    /**
+     * Dynamic bounding volume hierarchy over axis-aligned bounding boxes.
+     * Nodes live in one flat array and refer to each other by index. Leaves
+     * store enlarged ("fat") boxes so that small moves do not touch the tree,
+     * and every insertion or removal refits its ancestors with rotations that
+     * reduce their surface area.
+     */
+    class DynamicBVH
+    {
+      public:
+        /**
+         * Index returned for a missing node or proxy.
+         */
+        static constexpr int NULL_NODE {-1};
+
+        /**
+         * Constructs an empty DynamicBVH.
+         *
+         * @param margin The distance each leaf box is enlarged by on every side.
+         */
+        DynamicBVH(const float margin = 0.1f)
+        : margin(margin)
+        {}
+
+        /**
+         * Inserts a bounding box into the tree.
+         *
+         * @param box The tight bounding box of the object.
+         * @param userData The value reported by queries for this object.
+         * @return The proxy ID used to move or remove the object.
+         */
+        int insert(const kdr::space::AABB& box, const uint32_t userData);
+        /**
+         * Removes an object from the tree.
+         *
+         * @param proxyID The proxy ID returned by insert().
+         */
+        void remove(const int proxyID);
+        /**
+         * Updates the bounding box of an object. The tree is only modified when
+         * the new box leaves the enlarged box stored in the leaf.
+         *
+         * @param proxyID The proxy ID returned by insert().
+         * @param box The new tight bounding box of the object.
+         * @param displacement The expected movement until the next update, used to extend the leaf box.
+         * @return True if the object was reinserted, false otherwise.
+         */
+        bool move(const int proxyID, const kdr::space::AABB& box, const kdr::space::Vec3& displacement = {0.f});
+
+        /**
+         * Gets the user data of an object.
+         *
+         * @param proxyID The proxy ID returned by insert().
+         * @return The user data passed to insert().
+         */
+        uint32_t getUserData(const int proxyID) const
+        { return this->nodes[proxyID].userData; }
+        /**
+         * Gets the enlarged bounding box stored for an object.
+         *
+         * @param proxyID The proxy ID returned by insert().
+         * @return The enlarged bounding box.
+         */
+        const kdr::space::AABB& getFatAABB(const int proxyID) const
+        { return this->nodes[proxyID].box; }
+        /**
+         * Gets the number of objects in the tree.
+         *
+         * @return The number of leaves.
+         */
+        size_t getProxyCount() const
+        { return this->proxyCount; }
+        /**
+         * Gets the height of the tree.
+         *
+         * @return The height of the root node, or 0 for an empty tree.
+         */
+        int getHeight() const
+        { return this->root == NULL_NODE ? 0 : this->nodes[this->root].height; }
+
+        /**
+         * Finds all objects whose enlarged boxes overlap a bounding box.
+         *
+         * @param box The query box.
+         * @param results Receives the user data of the overlapping objects.
+         */
+        void queryAABB(const kdr::space::AABB& box, std::vector<uint32_t>& results) const;
+        /**
+         * Finds all objects whose enlarged boxes intersect a frustum. Subtrees
+         * fully inside the frustum are reported without further plane tests.
+         *
+         * @param frustum The query frustum.
+         * @param results Receives the user data of the intersecting objects.
+         */
+        void queryFrustum(const kdr::space::Frustum& frustum, std::vector<uint32_t>& results) const;
+        /**
+         * Finds all objects whose enlarged boxes are hit by a ray segment.
+         *
+         * @param ray The query ray.
+         * @param maxDistance The length of the segment, in units of the ray direction.
+         * @param results Receives the user data of the hit objects.
+         */
+        void queryRay(const kdr::space::Ray& ray, const float maxDistance, std::vector<uint32_t>& results) const;
+
+      private:
+        /**
+         * Tree node. Leaves have child1 == NULL_NODE; free nodes reuse parent as the free list link.
+         */
+        struct Node
+        {
+          kdr::space::AABB box;
+          int      parent   {NULL_NODE};
+          int      child1   {NULL_NODE};
+          int      child2   {NULL_NODE};
+          int      height   {0};
+          uint32_t userData {0};
+
+          bool isLeaf() const
+          { return this->child1 == NULL_NODE; }
+        };
+
+        std::vector<Node> nodes;
+        int    root       {NULL_NODE};
+        int    freeList   {NULL_NODE};
+        size_t proxyCount {0};
+        float  margin     {0.1f};
+
+        /**
+         * Takes a node from the free list, growing the node array when empty.
+         *
+         * @return The index of the allocated node.
+         */
+        int _allocateNode();
+        /**
+         * Returns a node to the free list.
+         *
+         * @param index The index of the node.
+         */
+        void _freeNode(const int index);
+        /**
+         * Links a leaf into the tree next to the sibling with the lowest area cost.
+         *
+         * @param leaf The index of the leaf.
+         */
+        void _insertLeaf(const int leaf);
+        /**
+         * Unlinks a leaf from the tree.
+         *
+         * @param leaf The index of the leaf.
+         */
+        void _removeLeaf(const int leaf);
+        /**
+         * Recomputes boxes and heights from a node up to the root, rotating on the way.
+         *
+         * @param index The index of the first node to refit.
+         */
+        void _refit(int index);
+        /**
+         * Swaps a child with a grandchild if that reduces the surface area of the tree.
+         *
+         * @param index The index of an internal node.
+         * @return True if a rotation was applied, false otherwise.
+         */
+        bool _rotate(const int index);
+        /**
+         * Recomputes the box and height of an internal node from its children.
+         *
+         * @param index The index of an internal node.
+         */
+        void _updateNode(const int index);
+    };
+  }
+}
+
+#endif // KDR_SPATIAL_HPP
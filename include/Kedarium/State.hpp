@@ -0,0 +1,151 @@
+#ifndef KDR_STATE_HPP
+#define KDR_STATE_HPP
+
+#include <GL/glew.h>
+#include <stddef.h>
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Counters describing the calls routed through a StateCache.
+     */
+    struct StateCacheStats
+    {
+      size_t issued {0};
+      size_t elided {0};
+    };
+
+    /**
+     * Shadow copy of the OpenGL binding state that skips binds of objects
+     * which are already bound. Every kdr::gfx wrapper routes its binds
+     * through the cache of the calling thread, so code binding objects with
+     * raw GL calls must call invalidate() afterwards.
+     */
+    class StateCache
+    {
+      public:
+        /**
+         * Maximum number of texture units tracked; binds to higher units are always issued.
+         */
+        static constexpr int TEXTURE_UNIT_COUNT {32};
+
+        /**
+         * Constructs a StateCache with every binding unknown.
+         */
+        StateCache()
+        { this->invalidate(); }
+
+        /**
+         * Gets the issued and elided call counters.
+         *
+         * @return The cache statistics.
+         */
+        const kdr::gfx::StateCacheStats& getStats() const
+        { return this->stats; }
+        /**
+         * Resets the issued and elided call counters.
+         */
+        void resetStats()
+        { this->stats = {}; }
+
+        /**
+         * Forgets every cached binding so that the next bind of each kind is issued.
+         */
+        void invalidate();
+
+        /**
+         * Uses a shader program (glUseProgram).
+         *
+         * @param programID The ID of the program, or 0.
+         */
+        void useProgram(const GLuint programID);
+        /**
+         * Binds a vertex array object (glBindVertexArray).
+         *
+         * @param vaoID The ID of the VAO, or 0.
+         */
+        void bindVertexArray(const GLuint vaoID);
+        /**
+         * Binds a buffer object to a target (glBindBuffer).
+         *
+         * @param target The buffer target (e.g., GL_ARRAY_BUFFER).
+         * @param bufferID The ID of the buffer, or 0.
+         */
+        void bindBuffer(const GLenum target, const GLuint bufferID);
+        /**
+         * Binds a buffer object to an indexed binding point (glBindBufferBase).
+         * Indexed bindings are not tracked, so the call is always issued.
+         *
+         * @param target The indexed buffer target (e.g., GL_UNIFORM_BUFFER).
+         * @param index The binding point.
+         * @param bufferID The ID of the buffer, or 0.
+         */
+        void bindBufferBase(const GLenum target, const GLuint index, const GLuint bufferID);
+        /**
+         * Selects the active texture unit (glActiveTexture).
+         *
+         * @param unit The texture unit (e.g., GL_TEXTURE0).
+         */
+        void activeTexture(const GLenum unit);
+        /**
+         * Binds a texture to a target of the active texture unit (glBindTexture).
+         *
+         * @param target The texture target (e.g., GL_TEXTURE_2D).
+         * @param textureID The ID of the texture, or 0.
+         */
+        void bindTexture(const GLenum target, const GLuint textureID);
+
+        /**
+         * Forgets a deleted program, which OpenGL unbinds implicitly.
+         *
+         * @param programID The ID of the program.
+         */
+        void forgetProgram(const GLuint programID);
+        /**
+         * Forgets a deleted vertex array object, which OpenGL unbinds implicitly.
+         *
+         * @param vaoID The ID of the VAO.
+         */
+        void forgetVertexArray(const GLuint vaoID);
+        /**
+         * Forgets a deleted buffer object, which OpenGL unbinds implicitly.
+         *
+         * @param bufferID The ID of the buffer.
+         */
+        void forgetBuffer(const GLuint bufferID);
+        /**
+         * Forgets a deleted texture, which OpenGL unbinds implicitly.
+         *
+         * @param textureID The ID of the texture.
+         */
+        void forgetTexture(const GLuint textureID);
+
+      private:
+        /**
+         * Value of a binding that has not been observed yet.
+         */
+        static constexpr GLuint UNKNOWN {0xffffffff};
+        static constexpr int BUFFER_TARGET_COUNT  {8};
+        static constexpr int TEXTURE_TARGET_COUNT {4};
+
+        GLuint program {UNKNOWN};
+        GLuint vertexArray {UNKNOWN};
+        GLuint buffers[BUFFER_TARGET_COUNT];
+        GLenum activeUnit {UNKNOWN};
+        GLuint textures[TEXTURE_UNIT_COUNT][TEXTURE_TARGET_COUNT];
+
+        kdr::gfx::StateCacheStats stats;
+    };
+
+    /**
+     * Gets the state cache of the OpenGL context current on the calling thread.
+     *
+     * @return The state cache of the calling thread.
+     */
+    kdr::gfx::StateCache& getStateCache();
+  }
+}
+
+#endif // KDR_STATE_HPP
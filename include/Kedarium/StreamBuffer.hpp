@@ -0,0 +1,126 @@
+#ifndef KDR_STREAM_BUFFER_HPP
+#define KDR_STREAM_BUFFER_HPP
+
+#include <GL/glew.h>
+#include <stddef.h>
+
+#include "State.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Ring buffer for data rewritten every frame, such as particles, UI and
+     * debug lines. The buffer is split into one region per frame in flight,
+     * and each region is fenced after the draws reading it, so the CPU only
+     * waits when it gets more than REGION_COUNT frames ahead of the GPU.
+     *
+     * With GL_ARB_buffer_storage the whole buffer stays persistently and
+     * coherently mapped. Otherwise each region is mapped with
+     * glMapBufferRange using unsynchronized, invalidating writes for the
+     * duration of a frame.
+     *
+     * Per frame: BeginFrame(), Allocate() and write, Flush(), issue the draws,
+     * then EndFrame().
+     */
+    class StreamBuffer
+    {
+      public:
+        /**
+         * Number of regions, one per frame that may be in flight.
+         */
+        static constexpr int REGION_COUNT {3};
+
+        /**
+         * Constructs a StreamBuffer.
+         *
+         * @param target The buffer target (e.g., GL_ARRAY_BUFFER).
+         * @param regionSize The number of bytes that can be allocated per frame.
+         */
+        StreamBuffer(GLenum target, GLsizeiptr regionSize);
+
+        /**
+         * Gets the ID of the stream buffer.
+         *
+         * @return The OpenGL identifier (ID) of the buffer.
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * Gets the number of bytes that can be allocated per frame.
+         *
+         * @return The region size in bytes.
+         */
+        GLsizeiptr getRegionSize() const
+        { return this->regionSize; }
+        /**
+         * Gets whether the buffer is persistently mapped.
+         *
+         * @return True if GL_ARB_buffer_storage is used, false for the glMapBufferRange fallback.
+         */
+        bool isPersistent() const
+        { return this->persistent; }
+        /**
+         * Gets how many times BeginFrame() had to wait for the GPU.
+         *
+         * @return The number of blocking fence waits.
+         */
+        size_t getStallCount() const
+        { return this->stallCount; }
+
+        /**
+         * Moves to the next region, waiting for the GPU to release it if needed.
+         */
+        void BeginFrame();
+        /**
+         * Reserves space in the region of the current frame.
+         *
+         * @param size The number of bytes to reserve.
+         * @param offset Receives the byte offset of the reservation from the start of the buffer.
+         * @param alignment The alignment of the offset; pass the vertex stride to use offset / stride as the first vertex.
+         * @return A pointer to write the data to, or NULL if the region is full.
+         */
+        void* Allocate(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment = 16);
+        /**
+         * Makes the data written this frame visible to the GPU. Must be called before drawing from it.
+         */
+        void Flush();
+        /**
+         * Fences the region of the current frame. Must be called after the draws reading it.
+         */
+        void EndFrame();
+
+        /**
+         * Binds the stream buffer to the OpenGL context.
+         */
+        void Bind()
+        { kdr::gfx::getStateCache().bindBuffer(this->target, this->ID); }
+        /**
+         * Unbinds the currently bound stream buffer from the OpenGL context.
+         */
+        void Unbind()
+        { kdr::gfx::getStateCache().bindBuffer(this->target, 0); }
+        /**
+         * Deletes the stream buffer, freeing up associated resources in the GPU.
+         */
+        void Delete();
+
+      private:
+        GLuint     ID;
+        GLenum     target;
+        GLsizeiptr regionSize;
+        bool       persistent {false};
+
+        char*  mapping    {NULL};
+        char*  regionData {NULL};
+        int    region     {REGION_COUNT - 1};
+        GLsync fences[REGION_COUNT] {};
+
+        GLsizeiptr head       {0};
+        size_t     stallCount {0};
+    };
+  }
+}
+
+#endif // KDR_STREAM_BUFFER_HPP
@@ -0,0 +1,202 @@
+#ifndef KDR_TEXTURE_ATLAS_HPP
+#define KDR_TEXTURE_ATLAS_HPP
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+#include "Graphics.hpp"
+#include "Image.hpp"
+#include "ImageFormat.hpp"
+#include "Space.hpp"
+#include "State.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Rectangle packer keeping the skyline of the packed rectangles. Each
+     * rectangle goes to the lowest position it fits at, leftmost on ties.
+     */
+    class SkylinePacker
+    {
+      public:
+        /**
+         * Constructs an empty SkylinePacker.
+         *
+         * @param width The width of the packing area.
+         * @param height The height of the packing area.
+         */
+        SkylinePacker(const int width, const int height);
+
+        /**
+         * Finds a place for a rectangle and reserves it.
+         *
+         * @param width The width of the rectangle.
+         * @param height The height of the rectangle.
+         * @param x Receives the left edge of the placed rectangle.
+         * @param y Receives the bottom edge of the placed rectangle.
+         * @return True if the rectangle was placed, false if it does not fit.
+         */
+        bool pack(const int width, const int height, int& x, int& y);
+        /**
+         * Removes all packed rectangles.
+         */
+        void clear();
+
+      private:
+        /**
+         * Horizontal run of the skyline.
+         */
+        struct Segment
+        {
+          int x;
+          int y;
+          int width;
+        };
+
+        int width;
+        int height;
+        std::vector<Segment> skyline;
+
+        /**
+         * Gets the height a rectangle would rest at when its left edge is at a segment.
+         *
+         * @param index The index of the segment.
+         * @param width The width of the rectangle.
+         * @return The resting height, or -1 if the rectangle does not fit there.
+         */
+        int _fit(const size_t index, const int width) const;
+    };
+
+    /**
+     * Location of an image inside a TextureAtlas.
+     */
+    struct AtlasRegion
+    {
+      GLint            layer {-1};
+      kdr::space::Vec2 uvMin;
+      kdr::space::Vec2 uvMax;
+    };
+
+    /**
+     * Texture built from many images packed into the layers of a
+     * GL_TEXTURE_2D_ARRAY, or into a single GL_TEXTURE_2D, so that draws
+     * using any of them share one texture bind.
+     */
+    class TextureAtlas
+    {
+      public:
+        /**
+         * Constructs an empty TextureAtlas.
+         *
+         * @param type GL_TEXTURE_2D_ARRAY for a layered atlas, or GL_TEXTURE_2D for a single atlas page.
+         * @param width The width of each layer.
+         * @param height The height of each layer.
+         * @param maxLayers The maximum number of layers; ignored for GL_TEXTURE_2D.
+         * @param padding The border kept around every image, in texels, filled with copies of its edge texels.
+         * @param sampler The sampling parameters. Mips are only generated for a mipmapped minification filter.
+         */
+        TextureAtlas(
+          GLenum type,
+          int width,
+          int height,
+          int maxLayers = 16,
+          int padding = 1,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState()
+        );
+
+        /**
+         * Gets the ID of the atlas texture.
+         *
+         * @return The OpenGL identifier (ID) of the texture, or 0 before Build().
+         */
+        GLuint getID() const
+        { return this->ID; }
+        /**
+         * Gets the number of layers used by the atlas.
+         *
+         * @return The number of layers.
+         */
+        int getLayerCount() const
+        { return this->layerCount; }
+        /**
+         * Gets where an image was packed.
+         *
+         * @param index The index returned by Add().
+         * @return The layer and UV rectangle of the image, valid after Build().
+         */
+        const kdr::gfx::AtlasRegion& getRegion(const int index) const
+        { return this->regions[index]; }
+
+        /**
+         * Queues a PNG, QOI or raw image for packing.
+         *
+         * @param imagePath The file path to the image.
+         * @return The index of the image, or -1 if it could not be loaded.
+         */
+        int Add(const std::string& imagePath);
+        /**
+         * Queues RGBA pixels for packing. The pixels are copied.
+         *
+         * @param pixels The RGBA8 pixels, bottom row first.
+         * @param width The width of the image.
+         * @param height The height of the image.
+         * @return The index of the image.
+         */
+        int Add(const GLubyte* pixels, int width, int height);
+        /**
+         * Packs the queued images, tallest first, and uploads the atlas.
+         * The queued pixels are released afterwards. Building again replaces
+         * the previous atlas texture.
+         *
+         * @return True if every image was packed, false otherwise.
+         */
+        bool Build();
+
+        /**
+         * Sets the texture unit of a shader sampler uniform. Uses the shader program.
+         *
+         * @param shader The shader program.
+         * @param uniform The name of the sampler uniform in the shader.
+         * @param unit The texture unit to bind.
+         */
+        void TextureUnit(kdr::gfx::Shader& shader, const std::string& uniform, GLuint unit);
+        /**
+         * Binds the atlas texture to the OpenGL context.
+         */
+        void Bind()
+        { kdr::gfx::getStateCache().bindTexture(this->type, this->ID); }
+        /**
+         * Unbinds the currently bound atlas texture from the OpenGL context.
+         */
+        void Unbind()
+        { kdr::gfx::getStateCache().bindTexture(this->type, 0); }
+        /**
+         * Deletes the atlas texture, freeing up associated resources in the GPU.
+         */
+        void Delete()
+        {
+          glDeleteTextures(1, &this->ID);
+          kdr::gfx::getStateCache().forgetTexture(this->ID);
+        }
+
+      private:
+        GLuint ID {0};
+        GLenum type;
+        int    width;
+        int    height;
+        int    maxLayers;
+        int    padding;
+        int    layerCount {0};
+
+        kdr::gfx::SamplerState sampler;
+
+        std::vector<kdr::img::Image>       images; // Waiting for Build()
+        std::vector<kdr::gfx::AtlasRegion> regions;
+    };
+  }
+}
+
+#endif // KDR_TEXTURE_ATLAS_HPP
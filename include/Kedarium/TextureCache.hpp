@@ -0,0 +1,144 @@
+#ifndef KDR_TEXTURE_CACHE_HPP
+#define KDR_TEXTURE_CACHE_HPP
+
+#include <GL/glew.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Graphics.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Counters describing how a TextureCache has been used.
+     */
+    struct TextureCacheStats
+    {
+      size_t hits      {0};
+      size_t misses    {0};
+      size_t evictions {0};
+    };
+
+    /**
+     * Shares one texture per source path and target through reference
+     * counting. Every texture is charged its video memory as reported by
+     * Texture::getMemorySize(), mip chain included when sampled. Textures no longer
+     * referenced stay cached in least-recently-released order and are
+     * evicted from the oldest once the total exceeds the budget; referenced
+     * textures are never evicted.
+     */
+    class TextureCache
+    {
+      public:
+        /**
+         * Constructs an empty TextureCache.
+         *
+         * @param budget The estimated video memory the cached textures may use, in bytes.
+         */
+        TextureCache(size_t budget)
+        : budget(budget)
+        {}
+
+        /**
+         * Gets the estimated video memory used by the cached textures.
+         *
+         * @return The usage in bytes, referenced and unreferenced textures alike.
+         */
+        size_t getUsage() const
+        { return this->usage; }
+        /**
+         * Gets the video memory budget.
+         *
+         * @return The budget in bytes.
+         */
+        size_t getBudget() const
+        { return this->budget; }
+        /**
+         * Gets the hit, miss and eviction counters.
+         *
+         * @return The cache statistics.
+         */
+        const kdr::gfx::TextureCacheStats& getStats() const
+        { return this->stats; }
+        /**
+         * Sets the video memory budget, evicting unreferenced textures if it is exceeded.
+         *
+         * @param budget The budget in bytes.
+         */
+        void setBudget(const size_t budget);
+
+        /**
+         * Estimates the video memory of a texture.
+         *
+         * @param width The width of the base level.
+         * @param height The height of the base level.
+         * @param bytesPerTexel The size of one texel in bytes.
+         * @param isMipmapped Whether the full mip chain is allocated.
+         * @return The estimated size in bytes.
+         */
+        static size_t estimateSize(int width, int height, const size_t bytesPerTexel, const bool isMipmapped);
+
+        /**
+         * Gets a texture, loading it on first use, and adds a reference to it.
+         *
+         * @param imagePath The file path to the PNG, QOI or raw image, or texture file.
+         * @param type The type of the texture (e.g., GL_TEXTURE_2D).
+         * @return The shared texture, valid until released and evicted, or NULL
+         * if the file could not be loaded. Failures are not cached, and a later
+         * call tries the file again.
+         */
+        kdr::gfx::Texture* Acquire(
+          const std::string& imagePath,
+          GLenum type = GL_TEXTURE_2D
+        );
+        /**
+         * Removes a reference to a texture returned by Acquire().
+         *
+         * @param texture The texture.
+         */
+        void Release(const kdr::gfx::Texture* texture);
+        /**
+         * Deletes every unreferenced texture.
+         */
+        void Trim();
+        /**
+         * Deletes every texture, referenced or not.
+         */
+        void Delete();
+
+      private:
+        /**
+         * Cached texture and its bookkeeping.
+         */
+        struct Entry
+        {
+          std::unique_ptr<kdr::gfx::Texture> texture;
+          size_t refCount {0};
+          size_t size     {0};
+          std::list<std::string>::iterator unusedPosition;
+        };
+
+        size_t budget;
+        size_t usage {0};
+
+        std::unordered_map<std::string, Entry> entries;
+        std::unordered_map<const kdr::gfx::Texture*, std::string> keys;
+        std::list<std::string> unused;
+
+        kdr::gfx::TextureCacheStats stats;
+
+        /**
+         * Evicts unreferenced textures, oldest first, until the usage fits the budget.
+         *
+         * @param budget The usage to get under.
+         */
+        void _evict(const size_t budget);
+    };
+  }
+}
+
+#endif // KDR_TEXTURE_CACHE_HPP
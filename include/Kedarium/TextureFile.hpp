@@ -0,0 +1,98 @@
+#ifndef KDR_TEXTURE_FILE_HPP
+#define KDR_TEXTURE_FILE_HPP
+
+#include <GL/glew.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace kdr
+{
+  namespace img
+  {
+    /**
+     * Pixel format of the levels stored in a texture file.
+     */
+    enum class PixelFormat : uint32_t
+    {
+      RGBA8,
+      SRGB8_ALPHA8,
+      BC1,
+      BC1_SRGB,
+      BC3,
+      BC3_SRGB,
+      BC7,
+      BC7_SRGB,
+      ETC2_RGB8,
+      ETC2_SRGB8,
+      ETC2_RGBA8,
+      ETC2_SRGB8_ALPHA8,
+    };
+
+    /**
+     * Gets whether a pixel format is block compressed.
+     *
+     * @param format The pixel format.
+     * @return True for the BCn and ETC2 formats, false otherwise.
+     */
+    bool isCompressed(const kdr::img::PixelFormat format);
+    /**
+     * Gets the OpenGL internal format matching a pixel format.
+     *
+     * @param format The pixel format.
+     * @return The internal format (e.g., GL_COMPRESSED_RGBA_BPTC_UNORM).
+     */
+    GLenum getInternalFormat(const kdr::img::PixelFormat format);
+    /**
+     * Gets the size of one level of a pixel format.
+     *
+     * @param format The pixel format.
+     * @param width The width of the level.
+     * @param height The height of the level.
+     * @return The size in bytes.
+     */
+    size_t getLevelSize(const kdr::img::PixelFormat format, const int width, const int height);
+
+    /**
+     * Texture with its precomputed mip levels, as stored in a texture file.
+     *
+     * On disk: the magic "KDTX", then the version, format, width, height and
+     * level count as 32-bit little-endian integers, then an offset and size
+     * per level, then the level data, each level aligned to 16 bytes.
+     */
+    struct TextureFile
+    {
+      kdr::img::PixelFormat             format {kdr::img::PixelFormat::RGBA8};
+      int                               width  {0};
+      int                               height {0};
+      std::vector<std::vector<uint8_t>> levels;
+    };
+
+    /**
+     * Checks whether a file starts with the texture file magic.
+     *
+     * @param path The file path.
+     * @return True if the file is a texture file, false otherwise.
+     */
+    bool isTextureFile(const std::string& path);
+    /**
+     * Loads a texture file.
+     *
+     * @param path The file path.
+     * @param textureFile Receives the texture and its levels.
+     * @return True if the file is loaded successfully, false otherwise.
+     */
+    bool loadTextureFile(const std::string& path, kdr::img::TextureFile& textureFile);
+    /**
+     * Saves a texture file.
+     *
+     * @param path The file path.
+     * @param textureFile The texture and its levels.
+     * @return True if the file is saved successfully, false otherwise.
+     */
+    bool saveTextureFile(const std::string& path, const kdr::img::TextureFile& textureFile);
+  }
+}
+
+#endif // KDR_TEXTURE_FILE_HPP
@@ -0,0 +1,175 @@
+#ifndef KDR_TEXTURE_STREAMER_HPP
+#define KDR_TEXTURE_STREAMER_HPP
+
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Graphics.hpp"
+#include "Image.hpp"
+#include "ImageFormat.hpp"
+#include "Mipmap.hpp"
+#include "State.hpp"
+
+namespace kdr
+{
+  namespace gfx
+  {
+    /**
+     * Loads textures in the background through pixel buffer objects.
+     *
+     * Worker threads read the image header (PNG, QOI or raw), then decode
+     * the image into a pixel buffer object mapped by the GL thread. When the
+     * sampler's minification filter samples mips, the workers also filter
+     * the mip chain (box filter) into the same buffer. Update() runs once
+     * per frame on the GL thread and copies at most a byte budget of rows
+     * from the pixel buffers into their textures with glTexSubImage2D, base
+     * level first, so the GL thread never generates mips itself. Once every
+     * level is issued, a fence tells when the texture is complete; until
+     * then getID() returns a shared placeholder texture.
+     */
+    class TextureStreamer
+    {
+      public:
+        /**
+         * Handle to a texture requested from the streamer.
+         */
+        using Handle = size_t;
+
+        /**
+         * Constructs a TextureStreamer and starts its worker threads.
+         *
+         * @param uploadBudget The number of bytes copied into textures per Update() call.
+         * @param workerCount The number of decoding threads, or 0 for one per hardware thread minus one.
+         * @param sampler The sampling parameters of the streamed textures.
+         */
+        TextureStreamer(
+          size_t uploadBudget = 4 * 1024 * 1024,
+          unsigned int workerCount = 0,
+          const kdr::gfx::SamplerState& sampler = kdr::gfx::SamplerState()
+        );
+        /**
+         * Stops the worker threads.
+         */
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /**
+         * Gets the texture to bind for a request.
+         *
+         * @param handle The handle returned by Request().
+         * @return The streamed texture once complete, the placeholder texture before.
+         */
+        GLuint getID(const Handle handle) const;
+        /**
+         * Gets whether a requested texture is complete.
+         *
+         * @param handle The handle returned by Request().
+         * @return True if the full mip chain has arrived, false otherwise.
+         */
+        bool isReady(const Handle handle) const;
+        /**
+         * Gets the number of requests that are neither complete nor failed.
+         *
+         * @return The number of pending requests.
+         */
+        size_t getPendingCount() const
+        { return this->activeJobs.size(); }
+
+        /**
+         * Requests a texture from a PNG, QOI or raw image. Returns immediately.
+         *
+         * @param imagePath The file path to the image.
+         * @return The handle of the texture.
+         */
+        Handle Request(const std::string& imagePath);
+        /**
+         * Advances the pending requests. Call once per frame on the GL thread.
+         */
+        void Update();
+        /**
+         * Deletes every streamed texture, the placeholder and the pixel buffers.
+         */
+        void Delete();
+
+      private:
+        /**
+         * Progress of a request. Steps marked (W) run on a worker thread, the others on the GL thread.
+         */
+        enum class Stage : int
+        {
+          ReadingHeader, // (W)
+          Mapping,
+          Decoding,      // (W)
+          Uploading,
+          Fenced,
+          Ready,
+          Failed,
+        };
+
+        /**
+         * State of one requested texture.
+         */
+        struct Job
+        {
+          std::string path;
+          std::atomic<Stage> stage {Stage::ReadingHeader};
+
+          int      width         {0};
+          int      height        {0};
+          int      levelCount    {1};
+          GLuint   textureID     {0};
+          GLuint   pboID         {0};
+          GLubyte* mapping       {NULL};
+          int      uploadedLevel {0};
+          int      uploadedRows  {0}; // Of the level being uploaded
+          size_t   levelOffset   {0}; // Of the level being uploaded, in the pixel buffer
+          GLsync   fence         {NULL};
+        };
+
+        size_t                 uploadBudget;
+        kdr::gfx::SamplerState sampler;
+        GLuint                 placeholderID {0};
+
+        std::vector<std::unique_ptr<Job>> jobs;
+        std::vector<Job*>                 activeJobs;
+
+        std::vector<std::thread> workers;
+        std::deque<Job*>         workQueue;
+        std::mutex               workMutex;
+        std::condition_variable  workCondition;
+        bool                     stopping {false};
+
+        /**
+         * Takes jobs from the work queue until the streamer stops.
+         */
+        void _work();
+        /**
+         * Stops and joins the worker threads.
+         */
+        void _stop();
+        /**
+         * Queues a job for the worker threads.
+         *
+         * @param job The job.
+         */
+        void _enqueue(Job* job);
+        /**
+         * Unmaps and deletes the pixel buffer of a job.
+         *
+         * @param job The job.
+         */
+        void _releaseBuffer(Job& job);
+    };
+  }
+}
+
+#endif // KDR_TEXTURE_STREAMER_HPP
@@ -8,6 +8,7 @@
 
 #include "Color.hpp"
 #include "Graphics.hpp"
+#include "RenderQueue.hpp"
 #include "Camera.hpp"
 
 namespace kdr
@@ -109,6 +110,13 @@ namespace kdr
        */
       kdr::Camera* getBoundCamera() const
       { return this->boundCamera; }
+      /**
+       * Gets the render queue executed after each render() call.
+       *
+       * @return A reference to the render queue of the window.
+       */
+      kdr::gfx::RenderQueue& getRenderQueue()
+      { return this->renderQueue; }
 
       /**
        * Sets the clear color for the window.
@@ -150,14 +158,18 @@ namespace kdr
        */
       void unmaximize();
       /**
-       * Binds a shader for rendering.
+       * Binds a shader for rendering. Shaders get the camera through the
+       * FrameConstants block; for shaders still declaring a cameraMatrix
+       * uniform, it is looked up when a different shader gets bound.
        *
        * @param shader The shader to be bound.
        */
       void bindShader(kdr::gfx::Shader& shader)
       {
         shader.Use();
-        this->boundShaderID = shader.getID();
+        if (this->boundShaderID == shader.getID()) return;
+        this->boundShaderID        = shader.getID();
+        this->cameraMatrixLocation = shader.getUniformLocation("cameraMatrix");
       }
 
     protected:
@@ -184,8 +196,12 @@ namespace kdr
       GLFWwindow*      glfwWindow {NULL};
       kdr::Color::RGBA clearColor = kdr::Color::Black;
 
-      kdr::Camera* boundCamera   {NULL};
-      GLuint       boundShaderID {0};
+      kdr::gfx::RenderQueue    renderQueue;
+      kdr::gfx::UniformBuffer* frameConstantsBuffer {NULL};
+
+      kdr::Camera* boundCamera          {NULL};
+      GLuint       boundShaderID        {0};
+      GLint        cameraMatrixLocation {-1};
 
       /**
        * Initializes GLFW.
@@ -219,6 +235,10 @@ namespace kdr
        * @brief Updates the currently bound camera.
        */
       void _updateBoundCamera();
+      /**
+       * @brief Uploads the camera matrices and time to the FrameConstants buffer.
+       */
+      void _updateFrameConstants();
       /**
        * Updates the window.
        */
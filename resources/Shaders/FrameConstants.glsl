@@ -0,0 +1,8 @@
+layout (std140) uniform FrameConstants
+{
+  mat4  view;
+  mat4  projection;
+  mat4  viewProjection;
+  vec4  cameraPosition;
+  float time;
+};
@@ -0,0 +1,18 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aCol;
+layout (location = 2) in vec2 aTex;
+layout (location = 3) in mat4 aModel;
+
+#include "FrameConstants.glsl"
+
+out vec3 vertCol;
+out vec2 vertTex;
+
+void main()
+{
+  gl_Position = viewProjection * aModel * vec4(aPos, 1.f);
+  vertCol = aCol;
+  vertTex = aTex;
+}
@@ -0,0 +1,267 @@
+#include "Kedarium/AssetLoader.hpp"
+
+kdr::gfx::AssetLoader::AssetLoader(unsigned int workerCount, kdr::gfx::ProgramCache* cache)
+: cache(cache)
+{
+  if (workerCount == 0)
+  {
+    const unsigned int threadCount = std::thread::hardware_concurrency();
+    workerCount = threadCount > 1 ? threadCount - 1 : 1;
+  }
+  for (unsigned int i = 0; i < workerCount; i++)
+  {
+    this->workers.emplace_back(&kdr::gfx::AssetLoader::_work, this);
+  }
+}
+
+kdr::gfx::AssetLoader::~AssetLoader()
+{
+  this->_stop();
+}
+
+kdr::gfx::AssetLoader::Handle kdr::gfx::AssetLoader::LoadTexture(
+  const std::string& path,
+  const kdr::gfx::SamplerState& sampler,
+  const CompletionCallback& callback
+)
+{
+  std::unique_ptr<Job> job {new Job};
+  job->paths[0] = path;
+  job->sampler  = sampler;
+  job->callback = callback;
+  return this->_submit(std::move(job));
+}
+
+kdr::gfx::AssetLoader::Handle kdr::gfx::AssetLoader::LoadShader(
+  const std::string& vertexPath,
+  const std::string& fragmentPath,
+  const CompletionCallback& callback
+)
+{
+  std::unique_ptr<Job> job {new Job};
+  job->isShader = true;
+  job->paths[0] = vertexPath;
+  job->paths[1] = fragmentPath;
+  job->callback = callback;
+  return this->_submit(std::move(job));
+}
+
+void kdr::gfx::AssetLoader::Update(size_t uploadBudget)
+{
+  while (Job* job = this->_popDecoded())
+  {
+    this->uploads.push_back(job);
+  }
+
+  size_t uploaded {0};
+  while (!this->uploads.empty())
+  {
+    Job& job = *this->uploads.front();
+    if (job.stage == Stage::Failed)
+    {
+      this->uploads.pop_front();
+      this->_complete(job, false);
+      continue;
+    }
+
+    if (job.isShader)
+    {
+      // Only submitted here, picked up below once the driver has built it
+      job.future = kdr::gfx::compileShaderSource(job.sources[0], job.sources[1], this->cache);
+      job.sources[0].clear();
+      job.sources[1].clear();
+      job.stage = Stage::Building;
+      this->building.push_back(&job);
+      this->uploads.pop_front();
+      continue;
+    }
+
+    size_t size = job.image.getSize();
+    for (const std::vector<uint8_t>& level : job.textureFile.levels)
+    {
+      size += level.size();
+    }
+    if (uploaded > 0 && uploaded + size > uploadBudget) break;
+
+    if (job.isTextureFile)
+    {
+      job.texture.reset(new kdr::gfx::Texture(job.textureFile, GL_TEXTURE_2D, GL_TEXTURE0, job.sampler));
+    }
+    else
+    {
+      job.texture.reset(new kdr::gfx::Texture(job.image, GL_TEXTURE_2D, GL_TEXTURE0, job.sampler));
+    }
+    job.image       = kdr::img::Image();
+    job.textureFile = kdr::img::TextureFile();
+    uploaded += size;
+    this->uploads.pop_front();
+
+    // Texture files in a format the driver lacks leave the texture empty
+    const bool isLoaded = job.texture->getWidth() > 0;
+    if (!isLoaded)
+    {
+      job.texture->Delete();
+      job.texture.reset();
+    }
+    this->_complete(job, isLoaded);
+  }
+
+  for (size_t i = 0; i < this->building.size();)
+  {
+    Job& job = *this->building[i];
+    if (!job.future.isReady())
+    {
+      i++;
+      continue;
+    }
+
+    job.shader.reset(new kdr::gfx::Shader(std::move(job.future)));
+    GLint isLinked {GL_FALSE};
+    glGetProgramiv(job.shader->getID(), GL_LINK_STATUS, &isLinked);
+    if (!isLinked)
+    {
+      job.shader->Delete();
+      job.shader.reset();
+    }
+    this->building.erase(this->building.begin() + i);
+    this->_complete(job, isLinked);
+  }
+}
+
+void kdr::gfx::AssetLoader::Delete()
+{
+  this->_stop();
+
+  for (const std::unique_ptr<Job>& job : this->jobs)
+  {
+    if (job->texture) job->texture->Delete();
+    if (job->shader) job->shader->Delete();
+    job->future.Delete();
+  }
+  this->jobs.clear();
+  this->uploads.clear();
+  this->building.clear();
+  this->completedCount = 0;
+  this->decodedHead = &this->decodedStub;
+  this->decodedTail = &this->decodedStub;
+  this->decodedStub.next = NULL;
+}
+
+void kdr::gfx::AssetLoader::_work()
+{
+  while (true)
+  {
+    Job* job {NULL};
+    {
+      std::unique_lock<std::mutex> lock(this->workMutex);
+      this->workCondition.wait(lock, [this]() {
+        return this->stopping || !this->workQueue.empty();
+      });
+      if (this->stopping) return;
+
+      job = this->workQueue.front();
+      this->workQueue.pop_front();
+    }
+
+    bool isRead {false};
+    if (job->isShader)
+    {
+      job->sources[0] = kdr::gfx::loadShaderSource(job->paths[0]);
+      job->sources[1] = kdr::gfx::loadShaderSource(job->paths[1]);
+      isRead = !job->sources[0].empty() && !job->sources[1].empty();
+    }
+    else
+    {
+      job->isTextureFile = kdr::img::isTextureFile(job->paths[0]);
+      isRead = job->isTextureFile ?
+        kdr::img::loadTextureFile(job->paths[0], job->textureFile) :
+        kdr::img::loadImage(job->paths[0], job->image, true);
+    }
+
+    job->stage = isRead ? Stage::Decoded : Stage::Failed;
+    this->_pushDecoded(job);
+  }
+}
+
+void kdr::gfx::AssetLoader::_stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workMutex);
+    this->stopping = true;
+  }
+  this->workCondition.notify_all();
+  for (std::thread& worker : this->workers)
+  {
+    worker.join();
+  }
+  this->workers.clear();
+  this->workQueue.clear();
+}
+
+kdr::gfx::AssetLoader::Handle kdr::gfx::AssetLoader::_submit(std::unique_ptr<Job> job)
+{
+  job->handle = this->jobs.size();
+  Job* pending = job.get();
+  this->jobs.push_back(std::move(job));
+
+  {
+    std::lock_guard<std::mutex> lock(this->workMutex);
+    this->workQueue.push_back(pending);
+  }
+  this->workCondition.notify_one();
+  return pending->handle;
+}
+
+void kdr::gfx::AssetLoader::_pushDecoded(Job* job)
+{
+  job->next.store(NULL, std::memory_order_relaxed);
+  Job* previous = this->decodedHead.exchange(job, std::memory_order_acq_rel);
+  previous->next.store(job, std::memory_order_release);
+}
+
+kdr::gfx::AssetLoader::Job* kdr::gfx::AssetLoader::_popDecoded()
+{
+  // Intrusive MPSC queue: the tail is popped once the job after it is linked,
+  // and the stub node keeps the queue non-empty when the last job is popped
+  Job* tail = this->decodedTail;
+  Job* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &this->decodedStub)
+  {
+    if (next == NULL) return NULL;
+    this->decodedTail = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != NULL)
+  {
+    this->decodedTail = next;
+    return tail;
+  }
+
+  // A worker swapped the head but has not linked its job yet
+  if (tail != this->decodedHead.load(std::memory_order_acquire)) return NULL;
+
+  this->_pushDecoded(&this->decodedStub);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != NULL)
+  {
+    this->decodedTail = next;
+    return tail;
+  }
+  return NULL;
+}
+
+void kdr::gfx::AssetLoader::_complete(Job& job, const bool isLoaded)
+{
+  job.stage = isLoaded ? Stage::Ready : Stage::Failed;
+  this->completedCount++;
+
+  if (job.callback)
+  {
+    job.callback(job.handle, isLoaded);
+  }
+  if (this->progressCallback)
+  {
+    this->progressCallback(this->completedCount, this->jobs.size());
+  }
+}
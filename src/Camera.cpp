@@ -2,60 +2,54 @@
 
 void kdr::Camera::updateMatrix()
 {
-  kdr::space::Mat4 view  {1.f};
-  kdr::space::Mat4 proj  {1.f};
-
-  view = kdr::space::translate(
-    view,
-    {
-      this->position.x,
-      this->position.y,
-      this->position.z
-    }
-  );
-  proj = kdr::space::perspective(
+  this->view       = kdr::space::translate(kdr::space::Mat4 {1.f}, this->position);
+  this->projection = kdr::space::perspective(
     this->fov,
     this->aspect,
     this->near,
     this->far
   );
 
-  this->matrix = proj * view;
+  this->matrix  = this->projection * this->view;
+  this->frustum = kdr::space::extractFrustum(this->matrix);
 }
 
-void kdr::Camera::applyMatrix(const GLuint shaderID, const std::string& uniformName)
+void kdr::Camera::applyMatrix(const GLint location)
 {
-  GLuint cameraMatrixLoc = glGetUniformLocation(shaderID, uniformName.c_str());
-  glUniformMatrix4fv(cameraMatrixLoc, 1, GL_FALSE, kdr::space::valuePointer(this->matrix));
+  glUniformMatrix4fv(location, 1, GL_FALSE, kdr::space::valuePointer(this->matrix));
 }
 
 void kdr::Camera::handleMovement(GLFWwindow* window)
 {
   if (!this->isMouseLocked) return;
 
+  const kdr::space::Vec3 frontStep = this->front * this->speed;
+  const kdr::space::Vec3 rightStep = kdr::space::cross(this->front, this->up) * this->speed;
+  const kdr::space::Vec3 upStep    = this->up * this->speed;
+
   if (kdr::keys::isPressed(window, kdr::Key::W))
   {
-    this->position -= this->front * this->speed;
+    this->position -= frontStep;
   }
   if (kdr::keys::isPressed(window, kdr::Key::S))
   {
-    this->position += this->front * this->speed;
+    this->position += frontStep;
   }
   if (kdr::keys::isPressed(window, kdr::Key::A))
   {
-    this->position -= kdr::space::cross(this->front, this->up) * this->speed;
+    this->position -= rightStep;
   }
   if (kdr::keys::isPressed(window, kdr::Key::D))
   {
-    this->position += kdr::space::cross(this->front, this->up) * this->speed;
+    this->position += rightStep;
   }
   if (kdr::keys::isPressed(window, kdr::Key::Space))
   {
-    this->position += this->up * this->speed;
+    this->position += upStep;
   }
   if (kdr::keys::isPressed(window, kdr::Key::LeftShift))
   {
-    this->position -= this->up * this->speed;
+    this->position -= upStep;
   }
 }
 
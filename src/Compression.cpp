@@ -0,0 +1,436 @@
+#include "Kedarium/Compression.hpp"
+
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * Reads the 4x4 block at a block position, repeating the edge pixels past the image.
+ */
+static void readBlock(const uint8_t* pixels, const int width, const int height, const int blockX, const int blockY, uint8_t block[16][4])
+{
+  for (int y = 0; y < 4; y++)
+  {
+    const int pixelY = blockY * 4 + y < height ? blockY * 4 + y : height - 1;
+    for (int x = 0; x < 4; x++)
+    {
+      const int pixelX = blockX * 4 + x < width ? blockX * 4 + x : width - 1;
+      const uint8_t* pixel = pixels + ((size_t)pixelY * width + pixelX) * 4;
+      for (int c = 0; c < 4; c++)
+      {
+        block[y * 4 + x][c] = pixel[c];
+      }
+    }
+  }
+}
+
+/**
+ * Fits a line through the first channels of a block along its principal
+ * axis and returns the extreme projections as endpoints.
+ */
+static void findEndpoints(const uint8_t block[16][4], const int channels, float low[4], float high[4])
+{
+  float mean[4] {0.f, 0.f, 0.f, 0.f};
+  for (int i = 0; i < 16; i++)
+  {
+    for (int c = 0; c < channels; c++)
+    {
+      mean[c] += block[i][c] / 16.f;
+    }
+  }
+
+  float covariance[4][4] {};
+  for (int i = 0; i < 16; i++)
+  {
+    for (int a = 0; a < channels; a++)
+    {
+      for (int b = 0; b < channels; b++)
+      {
+        covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+      }
+    }
+  }
+
+  // Power iteration, seeded with the diagonal of the bounding box
+  float axis[4] {0.f, 0.f, 0.f, 0.f};
+  for (int c = 0; c < channels; c++)
+  {
+    uint8_t minimum {255};
+    uint8_t maximum {0};
+    for (int i = 0; i < 16; i++)
+    {
+      minimum = block[i][c] < minimum ? block[i][c] : minimum;
+      maximum = block[i][c] > maximum ? block[i][c] : maximum;
+    }
+    axis[c] = (float)(maximum - minimum);
+  }
+  for (int iteration = 0; iteration < 8; iteration++)
+  {
+    float next[4] {0.f, 0.f, 0.f, 0.f};
+    float length {0.f};
+    for (int a = 0; a < channels; a++)
+    {
+      for (int b = 0; b < channels; b++)
+      {
+        next[a] += covariance[a][b] * axis[b];
+      }
+      length += next[a] * next[a];
+    }
+    if (length <= 0.f) break;
+
+    length = sqrtf(length);
+    for (int c = 0; c < channels; c++)
+    {
+      axis[c] = next[c] / length;
+    }
+  }
+
+  float length {0.f};
+  for (int c = 0; c < channels; c++)
+  {
+    length += axis[c] * axis[c];
+  }
+  if (length <= 0.f)
+  {
+    // Flat block
+    for (int c = 0; c < 4; c++)
+    {
+      low[c] = high[c] = mean[c];
+    }
+    return;
+  }
+  length = sqrtf(length);
+  for (int c = 0; c < channels; c++)
+  {
+    axis[c] /= length;
+  }
+
+  float minimum {0.f};
+  float maximum {0.f};
+  for (int i = 0; i < 16; i++)
+  {
+    float projection {0.f};
+    for (int c = 0; c < channels; c++)
+    {
+      projection += (block[i][c] - mean[c]) * axis[c];
+    }
+    minimum = projection < minimum ? projection : minimum;
+    maximum = projection > maximum ? projection : maximum;
+  }
+
+  for (int c = 0; c < 4; c++)
+  {
+    low[c]  = c < channels ? fminf(fmaxf(mean[c] + axis[c] * minimum, 0.f), 255.f) : mean[c];
+    high[c] = c < channels ? fminf(fmaxf(mean[c] + axis[c] * maximum, 0.f), 255.f) : mean[c];
+  }
+}
+
+static uint16_t packRGB565(const float color[4])
+{
+  const int red   = (int)(color[0] * 31.f / 255.f + 0.5f);
+  const int green = (int)(color[1] * 63.f / 255.f + 0.5f);
+  const int blue  = (int)(color[2] * 31.f / 255.f + 0.5f);
+  return (uint16_t)((red << 11) | (green << 5) | blue);
+}
+
+static void unpackRGB565(const uint16_t packed, int color[3])
+{
+  const int red   = (packed >> 11) & 31;
+  const int green = (packed >> 5) & 63;
+  const int blue  = packed & 31;
+  color[0] = (red << 3) | (red >> 2);
+  color[1] = (green << 2) | (green >> 4);
+  color[2] = (blue << 3) | (blue >> 2);
+}
+
+static void writeLittleEndian(uint8_t* output, uint64_t value, const int byteCount)
+{
+  for (int i = 0; i < byteCount; i++)
+  {
+    output[i] = (uint8_t)(value & 0xff);
+    value >>= 8;
+  }
+}
+
+/**
+ * Encodes the colors of a block as a BC1 block in four-color mode.
+ */
+static void encodeColorBlock(const uint8_t block[16][4], uint8_t output[8])
+{
+  float low[4];
+  float high[4];
+  findEndpoints(block, 3, low, high);
+
+  uint16_t color0 = packRGB565(high);
+  uint16_t color1 = packRGB565(low);
+  if (color0 < color1)
+  {
+    const uint16_t swapped = color0;
+    color0 = color1;
+    color1 = swapped;
+  }
+
+  // Equal endpoints leave every index at 0, which decodes to color0 in either mode
+  uint32_t indices {0};
+  if (color0 != color1)
+  {
+    int palette[4][3];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int i = 0; i < 16; i++)
+    {
+      int bestIndex    {0};
+      int bestDistance {0x7fffffff};
+      for (int p = 0; p < 4; p++)
+      {
+        int distance {0};
+        for (int c = 0; c < 3; c++)
+        {
+          const int delta = block[i][c] - palette[p][c];
+          distance += delta * delta;
+        }
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          bestIndex = p;
+        }
+      }
+      indices |= (uint32_t)bestIndex << (i * 2);
+    }
+  }
+
+  writeLittleEndian(output, color0, 2);
+  writeLittleEndian(output + 2, color1, 2);
+  writeLittleEndian(output + 4, indices, 4);
+}
+
+/**
+ * Encodes the alpha of a block as a BC4 block in eight-value mode.
+ */
+static void encodeAlphaBlock(const uint8_t block[16][4], uint8_t output[8])
+{
+  int alpha0 {0};
+  int alpha1 {255};
+  for (int i = 0; i < 16; i++)
+  {
+    alpha0 = block[i][3] > alpha0 ? block[i][3] : alpha0;
+    alpha1 = block[i][3] < alpha1 ? block[i][3] : alpha1;
+  }
+
+  uint64_t indices {0};
+  if (alpha0 != alpha1)
+  {
+    // Codes 0 and 1 are the endpoints, 2 to 7 step from alpha0 towards alpha1
+    int palette[8] {alpha0, alpha1};
+    for (int p = 2; p < 8; p++)
+    {
+      palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+    }
+
+    for (int i = 0; i < 16; i++)
+    {
+      int bestIndex    {0};
+      int bestDistance {256};
+      for (int p = 0; p < 8; p++)
+      {
+        const int distance = abs(block[i][3] - palette[p]);
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          bestIndex = p;
+        }
+      }
+      indices |= (uint64_t)bestIndex << (i * 3);
+    }
+  }
+
+  output[0] = (uint8_t)alpha0;
+  output[1] = (uint8_t)alpha1;
+  writeLittleEndian(output + 2, indices, 6);
+}
+
+/**
+ * Writes a bit field into a 128-bit block, least significant bit first.
+ */
+static void writeBits(uint8_t output[16], int& position, const uint32_t value, const int bitCount)
+{
+  for (int i = 0; i < bitCount; i++, position++)
+  {
+    output[position / 8] |= (uint8_t)(((value >> i) & 1) << (position % 8));
+  }
+}
+
+/**
+ * Quantizes an RGBA endpoint to 7 bits per channel and a shared parity
+ * bit, keeping the parity that reconstructs it most closely.
+ */
+static void quantizeEndpoint(const float endpoint[4], int quantized[4], int& parity)
+{
+  float bestError {INFINITY};
+  for (int p = 0; p < 2; p++)
+  {
+    int candidate[4];
+    float error {0.f};
+    for (int c = 0; c < 4; c++)
+    {
+      int value = (int)((endpoint[c] - p) / 2.f + 0.5f);
+      value = value < 0 ? 0 : (value > 127 ? 127 : value);
+      candidate[c] = value;
+
+      const float delta = (float)((value << 1) | p) - endpoint[c];
+      error += delta * delta;
+    }
+    if (error < bestError)
+    {
+      bestError = error;
+      parity = p;
+      for (int c = 0; c < 4; c++)
+      {
+        quantized[c] = candidate[c];
+      }
+    }
+  }
+}
+
+/**
+ * Encodes a block as a BC7 mode 6 block.
+ */
+static void encodeBC7Block(const uint8_t block[16][4], uint8_t output[16])
+{
+  static const int WEIGHTS[16] {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  float low[4];
+  float high[4];
+  findEndpoints(block, 4, low, high);
+
+  int endpoints[2][4];
+  int parities[2];
+  quantizeEndpoint(low, endpoints[0], parities[0]);
+  quantizeEndpoint(high, endpoints[1], parities[1]);
+
+  int decoded[2][4];
+  for (int e = 0; e < 2; e++)
+  {
+    for (int c = 0; c < 4; c++)
+    {
+      decoded[e][c] = (endpoints[e][c] << 1) | parities[e];
+    }
+  }
+
+  int indices[16];
+  for (int i = 0; i < 16; i++)
+  {
+    int bestIndex    {0};
+    int bestDistance {0x7fffffff};
+    for (int w = 0; w < 16; w++)
+    {
+      int distance {0};
+      for (int c = 0; c < 4; c++)
+      {
+        const int value = ((64 - WEIGHTS[w]) * decoded[0][c] + WEIGHTS[w] * decoded[1][c] + 32) >> 6;
+        distance += (block[i][c] - value) * (block[i][c] - value);
+      }
+      if (distance < bestDistance)
+      {
+        bestDistance = distance;
+        bestIndex = w;
+      }
+    }
+    indices[i] = bestIndex;
+  }
+
+  // The anchor index is stored without its top bit, which must then be 0
+  if (indices[0] >= 8)
+  {
+    for (int c = 0; c < 4; c++)
+    {
+      const int swapped = endpoints[0][c];
+      endpoints[0][c] = endpoints[1][c];
+      endpoints[1][c] = swapped;
+    }
+    const int swapped = parities[0];
+    parities[0] = parities[1];
+    parities[1] = swapped;
+    for (int i = 0; i < 16; i++)
+    {
+      indices[i] = 15 - indices[i];
+    }
+  }
+
+  for (int i = 0; i < 16; i++)
+  {
+    output[i] = 0;
+  }
+  int position {0};
+  writeBits(output, position, 1 << 6, 7);
+  for (int c = 0; c < 4; c++)
+  {
+    writeBits(output, position, endpoints[0][c], 7);
+    writeBits(output, position, endpoints[1][c], 7);
+  }
+  writeBits(output, position, parities[0], 1);
+  writeBits(output, position, parities[1], 1);
+  writeBits(output, position, indices[0], 3);
+  for (int i = 1; i < 16; i++)
+  {
+    writeBits(output, position, indices[i], 4);
+  }
+}
+
+void kdr::img::encodeBC1(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output)
+{
+  const int blocksX = kdr::img::getBlockCount(width);
+  const int blocksY = kdr::img::getBlockCount(height);
+  output.resize((size_t)blocksX * blocksY * 8);
+
+  uint8_t block[16][4];
+  for (int y = 0; y < blocksY; y++)
+  {
+    for (int x = 0; x < blocksX; x++)
+    {
+      readBlock(pixels, width, height, x, y, block);
+      encodeColorBlock(block, output.data() + ((size_t)y * blocksX + x) * 8);
+    }
+  }
+}
+
+void kdr::img::encodeBC3(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output)
+{
+  const int blocksX = kdr::img::getBlockCount(width);
+  const int blocksY = kdr::img::getBlockCount(height);
+  output.resize((size_t)blocksX * blocksY * 16);
+
+  uint8_t block[16][4];
+  for (int y = 0; y < blocksY; y++)
+  {
+    for (int x = 0; x < blocksX; x++)
+    {
+      uint8_t* target = output.data() + ((size_t)y * blocksX + x) * 16;
+      readBlock(pixels, width, height, x, y, block);
+      encodeAlphaBlock(block, target);
+      encodeColorBlock(block, target + 8);
+    }
+  }
+}
+
+void kdr::img::encodeBC7(const uint8_t* pixels, const int width, const int height, std::vector<uint8_t>& output)
+{
+  const int blocksX = kdr::img::getBlockCount(width);
+  const int blocksY = kdr::img::getBlockCount(height);
+  output.resize((size_t)blocksX * blocksY * 16);
+
+  uint8_t block[16][4];
+  for (int y = 0; y < blocksY; y++)
+  {
+    for (int x = 0; x < blocksX; x++)
+    {
+      readBlock(pixels, width, height, x, y, block);
+      encodeBC7Block(block, output.data() + ((size_t)y * blocksX + x) * 16);
+    }
+  }
+}
@@ -0,0 +1,272 @@
+#include "Kedarium/Culling.hpp"
+#include "Kedarium/Simd.hpp"
+
+static kdr::space::Plane makePlane(const float a, const float b, const float c, const float d)
+{
+  const float invLength = 1.f / kdr::space::sqrt(a * a + b * b + c * c);
+  return kdr::space::Plane {{a * invLength, b * invLength, c * invLength}, d * invLength};
+}
+
+static size_t compactMask(const unsigned int mask, const int width, const uint32_t base, uint32_t* out)
+{
+  size_t count = 0;
+  for (int lane = 0; lane < width; lane++)
+  {
+    out[count] = base + lane;
+    count += (mask >> lane) & 1;
+  }
+  return count;
+}
+
+kdr::space::Frustum kdr::space::extractFrustum(const kdr::space::Mat4& mat)
+{
+  // Gribb-Hartmann: each plane is the last row of the matrix plus or minus one of the others.
+  kdr::space::Frustum frustum;
+  const float row3[4] {mat[0][3], mat[1][3], mat[2][3], mat[3][3]};
+  for (int i = 0; i < 3; i++)
+  {
+    const float row[4] {mat[0][i], mat[1][i], mat[2][i], mat[3][i]};
+    frustum.planes[2 * i] = makePlane(
+      row3[0] + row[0],
+      row3[1] + row[1],
+      row3[2] + row[2],
+      row3[3] + row[3]
+    );
+    frustum.planes[2 * i + 1] = makePlane(
+      row3[0] - row[0],
+      row3[1] - row[1],
+      row3[2] - row[2],
+      row3[3] - row[3]
+    );
+  }
+  return frustum;
+}
+
+bool kdr::space::isVisible(const kdr::space::Frustum& frustum, const kdr::space::Sphere& sphere)
+{
+  for (const kdr::space::Plane& plane : frustum.planes)
+  {
+    if (kdr::space::dot(plane.normal, sphere.center) + plane.distance < -sphere.radius) return false;
+  }
+  return true;
+}
+
+bool kdr::space::isVisible(const kdr::space::Frustum& frustum, const kdr::space::AABB& box)
+{
+  const kdr::space::Vec3 center = (box.min + box.max) * 0.5f;
+  const kdr::space::Vec3 extent = (box.max - box.min) * 0.5f;
+  for (const kdr::space::Plane& plane : frustum.planes)
+  {
+    const float radius = fabsf(plane.normal.x) * extent.x + fabsf(plane.normal.y) * extent.y + fabsf(plane.normal.z) * extent.z;
+    if (kdr::space::dot(plane.normal, center) + plane.distance + radius < 0.f) return false;
+  }
+  return true;
+}
+
+void kdr::space::cullSpheres(
+  const kdr::space::Frustum& frustum,
+  const kdr::space::SphereArray& spheres,
+  std::vector<uint32_t>& visibleIndices
+)
+{
+  const size_t count = spheres.size();
+  visibleIndices.resize(count);
+  uint32_t* out = visibleIndices.data();
+  size_t visibleCount = 0;
+  size_t i = 0;
+
+  const float* xs    = spheres.xs.data();
+  const float* ys    = spheres.ys.data();
+  const float* zs    = spheres.zs.data();
+  const float* radii = spheres.radii.data();
+
+#if defined(KDR_SIMD_AVX)
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(xs + i);
+    const __m256 y = _mm256_loadu_ps(ys + i);
+    const __m256 z = _mm256_loadu_ps(zs + i);
+    const __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radii + i));
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      __m256 dist = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), x);
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), y));
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), z));
+      dist = _mm256_add_ps(dist, _mm256_set1_ps(plane.distance));
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+      if (_mm256_movemask_ps(inside) == 0) break;
+    }
+    visibleCount += compactMask(_mm256_movemask_ps(inside), 8, i, out + visibleCount);
+  }
+#elif defined(KDR_SIMD_SSE)
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 x = _mm_loadu_ps(xs + i);
+    const __m128 y = _mm_loadu_ps(ys + i);
+    const __m128 z = _mm_loadu_ps(zs + i);
+    const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      __m128 dist = _mm_mul_ps(_mm_set1_ps(plane.normal.x), x);
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.y), y));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.z), z));
+      dist = _mm_add_ps(dist, _mm_set1_ps(plane.distance));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negR));
+      if (_mm_movemask_ps(inside) == 0) break;
+    }
+    visibleCount += compactMask(_mm_movemask_ps(inside), 4, i, out + visibleCount);
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t x = vld1q_f32(xs + i);
+    const float32x4_t y = vld1q_f32(ys + i);
+    const float32x4_t z = vld1q_f32(zs + i);
+    const float32x4_t negR = vnegq_f32(vld1q_f32(radii + i));
+    uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      float32x4_t dist = vmulq_n_f32(x, plane.normal.x);
+      dist = vaddq_f32(dist, vmulq_n_f32(y, plane.normal.y));
+      dist = vaddq_f32(dist, vmulq_n_f32(z, plane.normal.z));
+      dist = vaddq_f32(dist, vdupq_n_f32(plane.distance));
+      inside = vandq_u32(inside, vcgeq_f32(dist, negR));
+    }
+    const unsigned int mask =
+      (vgetq_lane_u32(inside, 0) & 1) |
+      (vgetq_lane_u32(inside, 1) & 2) |
+      (vgetq_lane_u32(inside, 2) & 4) |
+      (vgetq_lane_u32(inside, 3) & 8);
+    visibleCount += compactMask(mask, 4, i, out + visibleCount);
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    bool inside = true;
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      const float dist = plane.normal.x * xs[i] + plane.normal.y * ys[i] + plane.normal.z * zs[i] + plane.distance;
+      inside = inside && dist >= -radii[i];
+    }
+    out[visibleCount] = i;
+    visibleCount += inside;
+  }
+
+  visibleIndices.resize(visibleCount);
+}
+
+void kdr::space::cullAABBs(
+  const kdr::space::Frustum& frustum,
+  const kdr::space::AABBArray& boxes,
+  std::vector<uint32_t>& visibleIndices
+)
+{
+  const size_t count = boxes.size();
+  visibleIndices.resize(count);
+  uint32_t* out = visibleIndices.data();
+  size_t visibleCount = 0;
+  size_t i = 0;
+
+  const float* cxs = boxes.centerXs.data();
+  const float* cys = boxes.centerYs.data();
+  const float* czs = boxes.centerZs.data();
+  const float* exs = boxes.extentXs.data();
+  const float* eys = boxes.extentYs.data();
+  const float* ezs = boxes.extentZs.data();
+
+#if defined(KDR_SIMD_AVX)
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 cx = _mm256_loadu_ps(cxs + i);
+    const __m256 cy = _mm256_loadu_ps(cys + i);
+    const __m256 cz = _mm256_loadu_ps(czs + i);
+    const __m256 ex = _mm256_loadu_ps(exs + i);
+    const __m256 ey = _mm256_loadu_ps(eys + i);
+    const __m256 ez = _mm256_loadu_ps(ezs + i);
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      __m256 dist = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), cx);
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), cy));
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), cz));
+      dist = _mm256_add_ps(dist, _mm256_set1_ps(plane.distance));
+      __m256 radius = _mm256_mul_ps(_mm256_set1_ps(fabsf(plane.normal.x)), ex);
+      radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(fabsf(plane.normal.y)), ey));
+      radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(fabsf(plane.normal.z)), ez));
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+      if (_mm256_movemask_ps(inside) == 0) break;
+    }
+    visibleCount += compactMask(_mm256_movemask_ps(inside), 8, i, out + visibleCount);
+  }
+#elif defined(KDR_SIMD_SSE)
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 cx = _mm_loadu_ps(cxs + i);
+    const __m128 cy = _mm_loadu_ps(cys + i);
+    const __m128 cz = _mm_loadu_ps(czs + i);
+    const __m128 ex = _mm_loadu_ps(exs + i);
+    const __m128 ey = _mm_loadu_ps(eys + i);
+    const __m128 ez = _mm_loadu_ps(ezs + i);
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      __m128 dist = _mm_mul_ps(_mm_set1_ps(plane.normal.x), cx);
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.y), cy));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.z), cz));
+      dist = _mm_add_ps(dist, _mm_set1_ps(plane.distance));
+      __m128 radius = _mm_mul_ps(_mm_set1_ps(fabsf(plane.normal.x)), ex);
+      radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(fabsf(plane.normal.y)), ey));
+      radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(fabsf(plane.normal.z)), ez));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+      if (_mm_movemask_ps(inside) == 0) break;
+    }
+    visibleCount += compactMask(_mm_movemask_ps(inside), 4, i, out + visibleCount);
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t cx = vld1q_f32(cxs + i);
+    const float32x4_t cy = vld1q_f32(cys + i);
+    const float32x4_t cz = vld1q_f32(czs + i);
+    const float32x4_t ex = vld1q_f32(exs + i);
+    const float32x4_t ey = vld1q_f32(eys + i);
+    const float32x4_t ez = vld1q_f32(ezs + i);
+    uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      float32x4_t dist = vmulq_n_f32(cx, plane.normal.x);
+      dist = vaddq_f32(dist, vmulq_n_f32(cy, plane.normal.y));
+      dist = vaddq_f32(dist, vmulq_n_f32(cz, plane.normal.z));
+      dist = vaddq_f32(dist, vdupq_n_f32(plane.distance));
+      float32x4_t radius = vmulq_n_f32(ex, fabsf(plane.normal.x));
+      radius = vaddq_f32(radius, vmulq_n_f32(ey, fabsf(plane.normal.y)));
+      radius = vaddq_f32(radius, vmulq_n_f32(ez, fabsf(plane.normal.z)));
+      inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(dist, radius), vdupq_n_f32(0.f)));
+    }
+    const unsigned int mask =
+      (vgetq_lane_u32(inside, 0) & 1) |
+      (vgetq_lane_u32(inside, 1) & 2) |
+      (vgetq_lane_u32(inside, 2) & 4) |
+      (vgetq_lane_u32(inside, 3) & 8);
+    visibleCount += compactMask(mask, 4, i, out + visibleCount);
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    bool inside = true;
+    for (const kdr::space::Plane& plane : frustum.planes)
+    {
+      const float dist = plane.normal.x * cxs[i] + plane.normal.y * cys[i] + plane.normal.z * czs[i] + plane.distance;
+      const float radius = fabsf(plane.normal.x) * exs[i] + fabsf(plane.normal.y) * eys[i] + fabsf(plane.normal.z) * ezs[i];
+      inside = inside && dist + radius >= 0.f;
+    }
+    out[visibleCount] = i;
+    visibleCount += inside;
+  }
+
+  visibleIndices.resize(visibleCount);
+}
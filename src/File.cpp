@@ -1,14 +1,208 @@
 #include "Kedarium/File.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+#include <algorithm>
+
+#include "Kedarium/Pack.hpp"
+
+kdr::file::FileView::~FileView()
+{
+  this->close();
+}
+
+kdr::file::FileView::FileView(kdr::file::FileView&& other)
+{
+  *this = std::move(other);
+}
+
+kdr::file::FileView& kdr::file::FileView::operator=(kdr::file::FileView&& other)
+{
+  if (this == &other) return *this;
+
+  this->close();
+  this->data       = other.data;
+  this->size       = other.size;
+  this->mapping    = other.mapping;
+  this->inflated   = std::move(other.inflated);
+  this->isInflated = other.isInflated;
+  // Short strings live inside the string object and move with it
+  if (this->isInflated) this->data = this->inflated.data();
+
+  other.mapping = NULL;
+  other.close();
+  return *this;
+}
+
+bool kdr::file::FileView::open(const std::string& path)
+{
+  this->close();
+
+  if (kdr::file::readPacked(path, this->data, this->size, this->inflated))
+  {
+    this->isInflated = this->data == this->inflated.data();
+    return true;
+  }
+  this->data = NULL;
+  this->size = 0;
+
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0) return false;
+
+  struct stat status;
+  if (fstat(file, &status) != 0)
+  {
+    ::close(file);
+    return false;
+  }
+  this->size = status.st_size;
+
+  // Empty files cannot be mapped
+  if (this->size == 0)
+  {
+    ::close(file);
+    this->data = "";
+    return true;
+  }
+
+  // The mapping stays valid once the descriptor is closed
+  void* mapping = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file);
+  if (mapping == MAP_FAILED)
+  {
+    this->size = 0;
+    return false;
+  }
+  this->mapping = mapping;
+  this->data    = (const char*)mapping;
+  return true;
+}
+
+void kdr::file::FileView::close()
+{
+  if (this->mapping != NULL)
+  {
+    munmap(this->mapping, this->size);
+  }
+  this->data       = NULL;
+  this->size       = 0;
+  this->mapping    = NULL;
+  this->isInflated = false;
+  this->inflated.clear();
+  this->inflated.shrink_to_fit();
+}
+
+kdr::file::ChunkReader::ChunkReader(const size_t chunkSize)
+: chunkSize(chunkSize > 0 ? chunkSize : 1)
+{}
+
+kdr::file::ChunkReader::~ChunkReader()
+{
+  this->close();
+}
+
+kdr::file::ChunkReader::ChunkReader(kdr::file::ChunkReader&& other)
+: chunkSize(other.chunkSize)
+{
+  *this = std::move(other);
+}
+
+kdr::file::ChunkReader& kdr::file::ChunkReader::operator=(kdr::file::ChunkReader&& other)
+{
+  if (this == &other) return *this;
+
+  this->close();
+  this->chunkSize = other.chunkSize;
+  this->file      = other.file;
+  this->buffer    = std::move(other.buffer);
+  this->packed    = other.packed;
+  this->size      = other.size;
+  this->position  = other.position;
+  if (other.packed != NULL && other.packed == other.inflated.data())
+  {
+    this->inflated = std::move(other.inflated);
+    this->packed   = this->inflated.data();
+  }
+
+  other.file = -1;
+  other.close();
+  return *this;
+}
+
+bool kdr::file::ChunkReader::open(const std::string& path)
+{
+  this->close();
+
+  if (kdr::file::readPacked(path, this->packed, this->size, this->inflated)) return true;
+  this->packed = NULL;
+  this->size   = 0;
+
+  this->file = ::open(path.c_str(), O_RDONLY);
+  if (this->file < 0) return false;
+
+  struct stat status;
+  if (fstat(this->file, &status) != 0)
+  {
+    this->close();
+    return false;
+  }
+  this->size = status.st_size;
+  posix_fadvise(this->file, 0, 0, POSIX_FADV_SEQUENTIAL);
+  return true;
+}
+
+void kdr::file::ChunkReader::close()
+{
+  if (this->file >= 0)
+  {
+    ::close(this->file);
+  }
+  this->inflated.clear();
+  this->inflated.shrink_to_fit();
+  this->file     = -1;
+  this->packed   = NULL;
+  this->size     = 0;
+  this->position = 0;
+}
+
+bool kdr::file::ChunkReader::read(std::string_view& chunk)
+{
+  const size_t length = std::min(this->chunkSize, this->size - this->position);
+  if (this->packed != NULL)
+  {
+    chunk = std::string_view(this->packed + this->position, length);
+    this->position += length;
+    return true;
+  }
+  if (this->file < 0) return false;
+
+  if (!this->buffer)
+  {
+    this->buffer.reset(new char[this->chunkSize]);
+  }
+  size_t filled {0};
+  while (filled < length)
+  {
+    const ssize_t count = ::read(this->file, this->buffer.get() + filled, length - filled);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) return false;
+    filled += count;
+  }
+  chunk = std::string_view(this->buffer.get(), length);
+  this->position += length;
+  return true;
+}
+
 std::string kdr::file::getContents(const std::string& path)
 {
-  std::ifstream file(path);
-  if (!file.is_open())
+  kdr::file::FileView file;
+  if (!file.open(path))
   {
     std::cerr << "Failed to open file (" << path << ")!\n";
     return "";
   }
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  return buffer.str();
+  return std::string(file.getView());
 }
@@ -0,0 +1,139 @@
+#include "Kedarium/GeometryPool.hpp"
+
+kdr::gfx::GeometryPool::GeometryPool(GLsizei vertexStride, GLuint maxVertices, GLuint maxIndices)
+: vertexStride(vertexStride), maxVertices(maxVertices), maxIndices(maxIndices)
+{
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+
+  glGenVertexArrays(1, &this->vaoID);
+  glGenBuffers(1, &this->vertexBufferID);
+  glGenBuffers(1, &this->indexBufferID);
+
+  // The element buffer binding is recorded in the VAO
+  state.bindVertexArray(this->vaoID);
+  state.bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferID);
+  glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)maxVertices * vertexStride, NULL, GL_STATIC_DRAW);
+  state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferID);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)maxIndices * sizeof(GLuint), NULL, GL_STATIC_DRAW);
+  state.bindVertexArray(0);
+  state.bindBuffer(GL_ARRAY_BUFFER, 0);
+
+  this->indirect = GLEW_ARB_multi_draw_indirect || GLEW_VERSION_4_3;
+  if (this->indirect)
+  {
+    glGenBuffers(1, &this->indirectBufferID);
+  }
+}
+
+void kdr::gfx::GeometryPool::LinkAttribute(GLuint layout, GLuint size, GLenum type, GLsizeiptr offset)
+{
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.bindVertexArray(this->vaoID);
+  state.bindBuffer(GL_ARRAY_BUFFER, this->vertexBufferID);
+  glVertexAttribPointer(layout, size, type, GL_FALSE, this->vertexStride, (const void*)offset);
+  glEnableVertexAttribArray(layout);
+  state.bindVertexArray(0);
+  state.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+int kdr::gfx::GeometryPool::AddMesh(const void* vertices, GLuint vertexCount, const GLuint* indices, GLuint indexCount)
+{
+  if (vertexCount > this->maxVertices - this->vertexCount) return -1;
+  if (indexCount > this->maxIndices - this->indexCount) return -1;
+
+  // Uploading through the copy target leaves the VAO state untouched
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.bindBuffer(GL_COPY_WRITE_BUFFER, this->vertexBufferID);
+  glBufferSubData(
+    GL_COPY_WRITE_BUFFER,
+    (GLintptr)this->vertexCount * this->vertexStride,
+    (GLsizeiptr)vertexCount * this->vertexStride,
+    vertices
+  );
+  state.bindBuffer(GL_COPY_WRITE_BUFFER, this->indexBufferID);
+  glBufferSubData(
+    GL_COPY_WRITE_BUFFER,
+    (GLintptr)this->indexCount * sizeof(GLuint),
+    (GLsizeiptr)indexCount * sizeof(GLuint),
+    indices
+  );
+  state.bindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  kdr::gfx::MeshRange mesh;
+  mesh.firstIndex  = this->indexCount;
+  mesh.indexCount  = indexCount;
+  mesh.baseVertex  = this->vertexCount;
+  mesh.vertexCount = vertexCount;
+  this->meshes.push_back(mesh);
+
+  this->vertexCount += vertexCount;
+  this->indexCount  += indexCount;
+  return this->meshes.size() - 1;
+}
+
+void kdr::gfx::GeometryPool::Draw(const std::vector<uint32_t>& meshIDs, GLenum mode)
+{
+  if (meshIDs.empty()) return;
+
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.bindVertexArray(this->vaoID);
+
+  const GLsizei drawCount = meshIDs.size();
+  if (this->indirect)
+  {
+    this->commands.resize(drawCount);
+    for (GLsizei i = 0; i < drawCount; i++)
+    {
+      const kdr::gfx::MeshRange& mesh = this->meshes[meshIDs[i]];
+      this->commands[i] = {mesh.indexCount, 1, mesh.firstIndex, mesh.baseVertex, (GLuint)i};
+    }
+
+    // Orphan the previous command list instead of waiting for the draws reading it
+    const GLsizeiptr size = drawCount * sizeof(kdr::gfx::DrawElementsIndirectCommand);
+    state.bindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirectBufferID);
+    if (size > this->indirectCapacity)
+    {
+      this->indirectCapacity = size;
+    }
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, this->indirectCapacity, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, this->commands.data());
+    glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, NULL, drawCount, 0);
+    return;
+  }
+
+  this->counts.resize(drawCount);
+  this->offsets.resize(drawCount);
+  this->baseVertices.resize(drawCount);
+  for (GLsizei i = 0; i < drawCount; i++)
+  {
+    const kdr::gfx::MeshRange& mesh = this->meshes[meshIDs[i]];
+    this->counts[i]       = mesh.indexCount;
+    this->offsets[i]      = (const void*)((uintptr_t)mesh.firstIndex * sizeof(GLuint));
+    this->baseVertices[i] = mesh.baseVertex;
+  }
+  glMultiDrawElementsBaseVertex(
+    mode,
+    this->counts.data(),
+    GL_UNSIGNED_INT,
+    this->offsets.data(),
+    drawCount,
+    this->baseVertices.data()
+  );
+}
+
+void kdr::gfx::GeometryPool::Delete()
+{
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+
+  glDeleteVertexArrays(1, &this->vaoID);
+  state.forgetVertexArray(this->vaoID);
+  glDeleteBuffers(1, &this->vertexBufferID);
+  state.forgetBuffer(this->vertexBufferID);
+  glDeleteBuffers(1, &this->indexBufferID);
+  state.forgetBuffer(this->indexBufferID);
+  if (this->indirectBufferID != 0)
+  {
+    glDeleteBuffers(1, &this->indirectBufferID);
+    state.forgetBuffer(this->indirectBufferID);
+  }
+}
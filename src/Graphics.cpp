@@ -1,56 +1,316 @@
 #include "Kedarium/Graphics.hpp"
 
-kdr::gfx::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+static_assert(sizeof(kdr::gfx::FrameConstants) == 224, "FrameConstants must match the std140 block layout");
+
+// Deepest chain of #include directives expanded in a shader source
+static constexpr int MAX_INCLUDE_DEPTH {16};
+
+static std::string readShaderSource(const std::string& path, const int depth = 0)
+{
+  kdr::file::FileView file;
+  if (!file.open(path))
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return "";
+  }
+  const std::string_view source = file.getView();
+  if (source.find("#include") == std::string_view::npos) return std::string(source);
+
+  const size_t slash = path.find_last_of('/');
+  const std::string directory = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+
+  std::string expanded;
+  expanded.reserve(source.size());
+  size_t lineStart = 0;
+  while (lineStart < source.size())
+  {
+    size_t lineEnd = source.find('\n', lineStart);
+    if (lineEnd == std::string_view::npos) lineEnd = source.size();
+
+    const size_t directive = source.find_first_not_of(" \t", lineStart);
+    const size_t open      = source.find('"', directive);
+    const size_t close     = open < lineEnd ? source.find('"', open + 1) : std::string_view::npos;
+    if (
+      directive < lineEnd &&
+      source.compare(directive, 8, "#include") == 0 &&
+      close < lineEnd &&
+      depth < MAX_INCLUDE_DEPTH
+    )
+    {
+      expanded += readShaderSource(directory + std::string(source.substr(open + 1, close - open - 1)), depth + 1);
+    }
+    else
+    {
+      expanded.append(source.data() + lineStart, lineEnd - lineStart);
+    }
+    expanded += '\n';
+    lineStart = lineEnd + 1;
+  }
+  return expanded;
+}
+
+std::string kdr::gfx::loadShaderSource(const std::string& path)
+{
+  return readShaderSource(path);
+}
+
+bool kdr::gfx::isFormatSupported(const kdr::img::PixelFormat format)
+{
+  switch (format)
+  {
+    case kdr::img::PixelFormat::RGBA8:
+    case kdr::img::PixelFormat::SRGB8_ALPHA8:
+      return true;
+    case kdr::img::PixelFormat::BC1:
+    case kdr::img::PixelFormat::BC3:
+      return GLEW_EXT_texture_compression_s3tc;
+    case kdr::img::PixelFormat::BC1_SRGB:
+    case kdr::img::PixelFormat::BC3_SRGB:
+      return GLEW_EXT_texture_compression_s3tc && GLEW_EXT_texture_sRGB;
+    case kdr::img::PixelFormat::BC7:
+    case kdr::img::PixelFormat::BC7_SRGB:
+      return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+    default:
+      return GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+  }
+}
+
+kdr::gfx::Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, kdr::gfx::ProgramCache* cache)
+: Shader(kdr::gfx::compileShader(vertexPath, fragmentPath, cache))
+{}
+
+kdr::gfx::Shader::Shader(kdr::gfx::ShaderFuture&& future)
+{
+  this->ID = future.programID;
+  const bool linked = future._finish();
+  future.programID = 0;
+
+  if (linked)
+  {
+    this->_reflect();
+  }
+}
+
+GLint kdr::gfx::Shader::getUniformLocation(const std::string& name) const
+{
+  const auto it = this->uniforms.find(name);
+  return it == this->uniforms.end() ? -1 : it->second.location;
+}
+
+GLint kdr::gfx::Shader::getAttributeLocation(const std::string& name) const
+{
+  const auto it = this->attributes.find(name);
+  return it == this->attributes.end() ? -1 : it->second.location;
+}
+
+void kdr::gfx::Shader::_reflect()
+{
+  GLint count     {0};
+  GLint maxLength {0};
+
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+  std::string name(maxLength > 0 ? maxLength : 1, '\0');
+  this->uniforms.reserve(count);
+  for (GLint i = 0; i < count; i++)
+  {
+    GLsizei length {0};
+    kdr::gfx::ShaderVariable variable;
+    glGetActiveUniform(this->ID, i, name.size(), &length, &variable.size, &variable.type, &name[0]);
+    std::string key = name.substr(0, length);
+
+    // Uniforms in blocks report -1 here and are set through their buffer instead
+    variable.location = glGetUniformLocation(this->ID, key.c_str());
+    if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0)
+    {
+      key.resize(key.size() - 3);
+    }
+    this->uniforms.emplace(std::move(key), variable);
+  }
+
+  glGetProgramiv(this->ID, GL_ACTIVE_ATTRIBUTES, &count);
+  glGetProgramiv(this->ID, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+  name.assign(maxLength > 0 ? maxLength : 1, '\0');
+  this->attributes.reserve(count);
+  for (GLint i = 0; i < count; i++)
+  {
+    GLsizei length {0};
+    kdr::gfx::ShaderVariable variable;
+    glGetActiveAttrib(this->ID, i, name.size(), &length, &variable.size, &variable.type, &name[0]);
+    std::string key = name.substr(0, length);
+
+    variable.location = glGetAttribLocation(this->ID, key.c_str());
+    this->attributes.emplace(std::move(key), variable);
+  }
+
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+  glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+  name.assign(maxLength > 0 ? maxLength : 1, '\0');
+  this->uniformBlocks.reserve(count);
+  for (GLint i = 0; i < count; i++)
+  {
+    GLsizei length {0};
+    glGetActiveUniformBlockName(this->ID, i, name.size(), &length, &name[0]);
+    this->uniformBlocks.emplace(name.substr(0, length), i);
+  }
+
+  // GLSL 3.30 cannot declare binding points, so the shared block is bound here
+  const auto frameConstants = this->uniformBlocks.find("FrameConstants");
+  if (frameConstants != this->uniformBlocks.end())
+  {
+    glUniformBlockBinding(this->ID, frameConstants->second, kdr::gfx::FRAME_CONSTANTS_BINDING);
+  }
+}
+
+kdr::gfx::ShaderFuture kdr::gfx::compileShader(
+  const std::string& vertexPath,
+  const std::string& fragmentPath,
+  kdr::gfx::ProgramCache* cache
+)
 {
-  const std::string vertexShaderSource = kdr::file::getContents(vertexPath);
-  const std::string fragmentShaderSource = kdr::file::getContents(fragmentPath);
+  return kdr::gfx::compileShaderSource(readShaderSource(vertexPath), readShaderSource(fragmentPath), cache);
+}
+
+kdr::gfx::ShaderFuture kdr::gfx::compileShaderSource(
+  const std::string& vertexShaderSource,
+  const std::string& fragmentShaderSource,
+  kdr::gfx::ProgramCache* cache
+)
+{
+  static bool parallelCompileEnabled {false};
+  if (!parallelCompileEnabled && GLEW_KHR_parallel_shader_compile)
+  {
+    // Let the driver pick as many compiler threads as it wants
+    glMaxShaderCompilerThreadsKHR(0xffffffff);
+    parallelCompileEnabled = true;
+  }
+
+  kdr::gfx::ShaderFuture future;
+  future.programID = glCreateProgram();
+
+  if (cache != NULL && cache->isSupported())
+  {
+    future.key = cache->makeKey(vertexShaderSource, fragmentShaderSource);
+    if (cache->load(future.key, future.programID))
+    {
+      return future;
+    }
+
+    // A rejected binary leaves the program unusable, so start over from source
+    glDeleteProgram(future.programID);
+    future.programID = glCreateProgram();
+    future.cache = cache;
+    glProgramParameteri(future.programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
 
   const char* vertexShaderSourceC = vertexShaderSource.c_str();
   const char* fragmentShaderSourceC = fragmentShaderSource.c_str();
 
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+  future.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+  future.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
 
-  glShaderSource(vertexShader, 1, &vertexShaderSourceC, NULL);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSourceC, NULL);
+  glShaderSource(future.vertexShader, 1, &vertexShaderSourceC, NULL);
+  glShaderSource(future.fragmentShader, 1, &fragmentShaderSourceC, NULL);
 
-  glCompileShader(vertexShader);
-  glCompileShader(fragmentShader);
+  glCompileShader(future.vertexShader);
+  glCompileShader(future.fragmentShader);
+
+  glAttachShader(future.programID, future.vertexShader);
+  glAttachShader(future.programID, future.fragmentShader);
+  glLinkProgram(future.programID);
+
+  return future;
+}
+
+kdr::gfx::ShaderFuture::ShaderFuture(kdr::gfx::ShaderFuture&& other)
+{
+  *this = std::move(other);
+}
+
+kdr::gfx::ShaderFuture& kdr::gfx::ShaderFuture::operator=(kdr::gfx::ShaderFuture&& other)
+{
+  if (this == &other) return *this;
+
+  this->Delete();
+  this->programID      = other.programID;
+  this->vertexShader   = other.vertexShader;
+  this->fragmentShader = other.fragmentShader;
+  this->key            = other.key;
+  this->cache          = other.cache;
+
+  other.programID      = 0;
+  other.vertexShader   = 0;
+  other.fragmentShader = 0;
+  other.cache          = NULL;
+  return *this;
+}
+
+void kdr::gfx::ShaderFuture::Delete()
+{
+  // Shaders still attached are freed along with the program
+  if (this->vertexShader != 0) glDeleteShader(this->vertexShader);
+  if (this->fragmentShader != 0) glDeleteShader(this->fragmentShader);
+  if (this->programID != 0) glDeleteProgram(this->programID);
+  this->programID      = 0;
+  this->vertexShader   = 0;
+  this->fragmentShader = 0;
+  this->cache          = NULL;
+}
+
+bool kdr::gfx::ShaderFuture::isReady() const
+{
+  if (this->vertexShader == 0) return true;
+  if (!GLEW_KHR_parallel_shader_compile) return true;
+
+  GLint completed {GL_FALSE};
+  glGetProgramiv(this->programID, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed;
+}
+
+bool kdr::gfx::ShaderFuture::_finish()
+{
+  // Programs linked from the cache were already checked by ProgramCache::load()
+  if (this->vertexShader == 0) return true;
 
   int success;
   char infoLog[512];
 
-  glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+  glGetShaderiv(this->vertexShader, GL_COMPILE_STATUS, &success);
   if (!success)
   {
-    glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+    glGetShaderInfoLog(this->vertexShader, 512, NULL, infoLog);
     std::cerr << "Failed to compile the vertex shader!\n";
     std::cerr << "Error: " << infoLog << '\n';
   }
 
-  glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+  glGetShaderiv(this->fragmentShader, GL_COMPILE_STATUS, &success);
   if (!success)
   {
-    glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+    glGetShaderInfoLog(this->fragmentShader, 512, NULL, infoLog);
     std::cerr << "Failed to compile the fragment shader!\n";
     std::cerr << "Error: " << infoLog << '\n';
   }
 
-  this->ID = glCreateProgram();
-  glAttachShader(this->ID, vertexShader);
-  glAttachShader(this->ID, fragmentShader);
-  glLinkProgram(this->ID);
-
-  glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+  glGetProgramiv(this->programID, GL_LINK_STATUS, &success);
   if (!success)
   {
-    glGetProgramInfoLog(this->ID, 512, NULL, infoLog);
-    std::cerr << "Failed to link the shader program (" << this->ID << ")!\n";
+    glGetProgramInfoLog(this->programID, 512, NULL, infoLog);
+    std::cerr << "Failed to link the shader program (" << this->programID << ")!\n";
     std::cerr << "Error: " << infoLog << '\n';
   }
 
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  glDetachShader(this->programID, this->vertexShader);
+  glDetachShader(this->programID, this->fragmentShader);
+  glDeleteShader(this->vertexShader);
+  glDeleteShader(this->fragmentShader);
+  this->vertexShader = 0;
+  this->fragmentShader = 0;
+
+  if (success && this->cache != NULL)
+  {
+    this->cache->store(this->key, this->programID);
+  }
+  return success;
 }
 
 kdr::gfx::VBO::VBO(GLfloat vertices[], GLsizeiptr size)
@@ -69,6 +329,44 @@ kdr::gfx::EBO::EBO(GLuint indices[], GLsizeiptr size)
   this->Unbind();
 }
 
+kdr::gfx::InstanceBuffer::InstanceBuffer(GLsizeiptr capacity)
+: capacity(capacity)
+{
+  glGenBuffers(1, &this->ID);
+  this->Bind();
+  glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_DYNAMIC_DRAW);
+  this->Unbind();
+}
+
+void kdr::gfx::InstanceBuffer::Update(const void* data, GLsizeiptr size)
+{
+  this->Bind();
+  if (size > this->capacity)
+  {
+    this->capacity = size;
+  }
+  glBufferData(GL_ARRAY_BUFFER, this->capacity, NULL, GL_DYNAMIC_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+  this->Unbind();
+}
+
+kdr::gfx::UniformBuffer::UniformBuffer(GLsizeiptr size, GLuint binding)
+: binding(binding), size(size)
+{
+  glGenBuffers(1, &this->ID);
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.bindBuffer(GL_UNIFORM_BUFFER, this->ID);
+  glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+  state.bindBufferBase(GL_UNIFORM_BUFFER, binding, this->ID);
+}
+
+void kdr::gfx::UniformBuffer::Update(const void* data, GLsizeiptr size)
+{
+  kdr::gfx::getStateCache().bindBuffer(GL_UNIFORM_BUFFER, this->ID);
+  glBufferData(GL_UNIFORM_BUFFER, this->size, NULL, GL_DYNAMIC_DRAW);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+}
+
 void kdr::gfx::VAO::LinkAttribute(kdr::gfx::VBO& VBO, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset)
 {
   VBO.Bind();
@@ -77,31 +375,195 @@ void kdr::gfx::VAO::LinkAttribute(kdr::gfx::VBO& VBO, GLuint layout, GLuint size
   VBO.Unbind();
 }
 
-kdr::gfx::Texture::Texture(const std::string& imagePath, GLenum type, GLenum slot, GLenum format, GLenum pixelType)
+void kdr::gfx::VAO::LinkAttribute(kdr::gfx::InstanceBuffer& buffer, GLuint layout, GLuint size, GLenum type, GLsizeiptr stride, const void* offset, GLuint divisor)
+{
+  buffer.Bind();
+  glVertexAttribPointer(layout, size, type, GL_FALSE, stride, offset);
+  glEnableVertexAttribArray(layout);
+  glVertexAttribDivisor(layout, divisor);
+  buffer.Unbind();
+}
+
+void kdr::gfx::VAO::LinkMatrixAttribute(kdr::gfx::InstanceBuffer& buffer, GLuint layout, GLsizeiptr stride, const void* offset, GLuint divisor)
+{
+  for (GLuint column = 0; column < 4; column++)
+  {
+    const char* columnOffset = (const char*)offset + column * 4 * sizeof(GLfloat);
+    this->LinkAttribute(buffer, layout + column, 4, GL_FLOAT, stride, columnOffset, divisor);
+  }
+}
+
+kdr::gfx::Texture::Texture(
+  const std::string& imagePath,
+  GLenum type,
+  GLenum slot,
+  const kdr::gfx::SamplerState& sampler
+)
+{
+  this->type = type;
+  this->_generate(slot, sampler);
+
+  if (kdr::img::isTextureFile(imagePath))
+  {
+    kdr::img::TextureFile textureFile;
+    if (kdr::img::loadTextureFile(imagePath, textureFile))
+    {
+      this->_uploadTextureFile(textureFile, imagePath);
+    }
+    this->Unbind();
+    return;
+  }
+
+  // A failed load leaves the texture empty, with a zero width
+  kdr::img::Image image;
+  if (kdr::img::loadImage(imagePath, image))
+  {
+    this->_uploadDecodedImage(image);
+  }
+  this->Unbind();
+}
+
+kdr::gfx::Texture::Texture(const kdr::img::Image& image, GLenum type, GLenum slot, const kdr::gfx::SamplerState& sampler)
 {
   this->type = type;
+  this->_generate(slot, sampler);
+  this->_uploadDecodedImage(image);
+  this->Unbind();
+}
 
-  int width     {0};
-  int height    {0};
-  GLubyte* data {NULL};
-  kdr::img::loadFromPNG(imagePath, &data, width, height);
+kdr::gfx::Texture::Texture(const kdr::img::TextureFile& textureFile, GLenum type, GLenum slot, const kdr::gfx::SamplerState& sampler)
+{
+  this->type = type;
+  this->_generate(slot, sampler);
+  this->_uploadTextureFile(textureFile, "texture file");
+  this->Unbind();
+}
+
+void kdr::gfx::Texture::_uploadDecodedImage(const kdr::img::Image& image)
+{
+  static const GLint GRAY_SWIZZLE[4]       {GL_RED, GL_RED, GL_RED, GL_ONE};
+  static const GLint GRAY_ALPHA_SWIZZLE[4] {GL_RED, GL_RED, GL_RED, GL_GREEN};
 
+  this->width  = image.getWidth();
+  this->height = image.getHeight();
+  // Rows of 1 to 3 channels are not always 4-byte aligned
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  switch (image.getChannels())
+  {
+    case 1:
+      glTexParameteriv(this->type, GL_TEXTURE_SWIZZLE_RGBA, GRAY_SWIZZLE);
+      this->_uploadImage(image.getData(), GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1);
+      break;
+    case 2:
+      glTexParameteriv(this->type, GL_TEXTURE_SWIZZLE_RGBA, GRAY_ALPHA_SWIZZLE);
+      this->_uploadImage(image.getData(), GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2);
+      break;
+    case 3:
+    {
+      // Drivers pad RGB8 to 4 bytes per texel anyway, and convert 3-byte texels on the slow path
+      kdr::img::Image expanded(image.getWidth(), image.getHeight(), 4);
+      kdr::img::expandRGBToRGBA(image.getData(), expanded.getData(), (size_t)image.getWidth() * image.getHeight());
+      this->_uploadImage(expanded.getData(), GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+      break;
+    }
+    default:
+      this->_uploadImage(image.getData(), GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+      break;
+  }
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void kdr::gfx::applySampler(GLenum type, const kdr::gfx::SamplerState& sampler)
+{
+  glTexParameteri(type, GL_TEXTURE_MIN_FILTER, sampler.minFilter);
+  glTexParameteri(type, GL_TEXTURE_MAG_FILTER, sampler.magFilter);
+  glTexParameteri(type, GL_TEXTURE_WRAP_S, sampler.wrapS);
+  glTexParameteri(type, GL_TEXTURE_WRAP_T, sampler.wrapT);
+
+  if (GLEW_VERSION_4_6 || GLEW_ARB_texture_filter_anisotropic || GLEW_EXT_texture_filter_anisotropic)
+  {
+    GLfloat limit {1.f};
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &limit);
+    glTexParameterf(type, GL_TEXTURE_MAX_ANISOTROPY, sampler.maxAnisotropy < limit ? sampler.maxAnisotropy : limit);
+  }
+}
+
+void kdr::gfx::Texture::setSampler(const kdr::gfx::SamplerState& sampler)
+{
+  this->sampler = sampler;
+  this->Bind();
+  kdr::gfx::applySampler(this->type, sampler);
+}
+
+void kdr::gfx::Texture::_generate(GLenum slot, const kdr::gfx::SamplerState& sampler)
+{
   glGenTextures(1, &this->ID);
-  glActiveTexture(slot);
-  glBindTexture(this->type, this->ID);
+  kdr::gfx::getStateCache().activeTexture(slot);
+  this->setSampler(sampler);
+}
+
+void kdr::gfx::Texture::_uploadImage(const void* pixels, GLenum internalFormat, GLenum format, GLenum pixelType, const int texelSize)
+{
+  glTexImage2D(this->type, 0, internalFormat, this->width, this->height, 0, format, pixelType, pixels);
 
-  glTexParameteri(this->type, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameteri(this->type, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  int width  = this->width;
+  int height = this->height;
+  this->memorySize = (size_t)width * height * texelSize;
+  if (!kdr::gfx::isMipmapFilter(this->sampler.minFilter))
+  {
+    // Mips would never be sampled; the base level alone keeps the texture complete
+    glTexParameteri(this->type, GL_TEXTURE_MAX_LEVEL, 0);
+    return;
+  }
 
-  glTexImage2D(this->type, 0, GL_RGBA, width, height, 0, format, pixelType, data);
   glGenerateMipmap(this->type);
+  while (width > 1 || height > 1)
+  {
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+    this->memorySize += (size_t)width * height * texelSize;
+  }
+}
+
+void kdr::gfx::Texture::_uploadTextureFile(const kdr::img::TextureFile& textureFile, const std::string& path)
+{
+  if (!kdr::gfx::isFormatSupported(textureFile.format))
+  {
+    std::cerr << "Unsupported texture format " << (uint32_t)textureFile.format << " (" << path << ")!\n";
+    return;
+  }
 
-  delete data;
-  glBindTexture(this->type, 0);
+  this->width  = textureFile.width;
+  this->height = textureFile.height;
+
+  // The stored levels are the whole mip chain, even when shorter than a full one
+  const GLenum internalFormat = kdr::img::getInternalFormat(textureFile.format);
+  const bool   isCompressed   = kdr::img::isCompressed(textureFile.format);
+  glTexParameteri(this->type, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(this->type, GL_TEXTURE_MAX_LEVEL, (GLint)textureFile.levels.size() - 1);
+
+  int width  = this->width;
+  int height = this->height;
+  for (size_t level = 0; level < textureFile.levels.size(); level++)
+  {
+    const std::vector<uint8_t>& data = textureFile.levels[level];
+    if (isCompressed)
+    {
+      glCompressedTexImage2D(this->type, level, internalFormat, width, height, 0, data.size(), data.data());
+    }
+    else
+    {
+      glTexImage2D(this->type, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    }
+    this->memorySize += data.size();
+
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
 }
 
-void kdr::gfx::Texture::TextureUnit(const GLuint shaderID, const std::string& uniform, GLuint unit)
+void kdr::gfx::Texture::TextureUnit(kdr::gfx::Shader& shader, const std::string& uniform, GLuint unit)
 {
-  GLuint texUnitLoc = glGetUniformLocation(shaderID, uniform.c_str());
-  glUniform1i(texUnitLoc, unit);
+  shader.Use();
+  shader.setInt(shader.getUniformLocation(uniform), unit);
 }
@@ -1,69 +1,283 @@
 #include "Kedarium/Image.hpp"
 
-bool kdr::img::loadFromPNG(const std::string& pngPath, GLubyte** data, int& imgWidth, int& imgHeight)
+#include <stdlib.h>
+#include <functional>
+
+#include "Kedarium/File.hpp"
+
+/**
+ * PNG being decoded from memory.
+ */
+struct PNGSource
+{
+  const char* data;
+  size_t      size;
+  size_t      position;
+};
+
+static void readPNGSource(png_structp pngPtr, png_bytep bytes, png_size_t length)
 {
-  png_structp  pngPtr;
-  png_infop    infoPtr;
-  unsigned int sigRead {0};
+  PNGSource& source = *(PNGSource*)png_get_io_ptr(pngPtr);
+  if (length > source.size - source.position)
+  {
+    png_error(pngPtr, "Truncated PNG");
+  }
+  memcpy(bytes, source.data + source.position, length);
+  source.position += length;
+}
 
-  FILE* file = fopen(pngPath.c_str(), "rb");
-  if (!file)
+/**
+ * Decodes a PNG file from a mapped view, see kdr::img::decodePNG().
+ */
+static bool readPNG(
+  const std::string& pngPath,
+  const bool isRGBA,
+  const std::function<GLubyte*(int width, int height, int channels)>& getBuffer
+)
+{
+  kdr::file::FileView file;
+  if (!file.open(pngPath))
   {
     std::cerr << "Failed to open file (" << pngPath << ")!\n";
     return false;
   }
+  return kdr::img::decodePNG(pngPath, (const uint8_t*)file.getData(), file.getSize(), isRGBA, getBuffer);
+}
+
+kdr::img::Image::Image(const int width, const int height, const int channels)
+: data(new GLubyte[(size_t)width * height * channels])
+, width(width)
+, height(height)
+, channels(channels)
+, owner(true)
+{}
+
+kdr::img::Image::Image(GLubyte* pixels, const int width, const int height, const int channels)
+: data(pixels)
+, width(width)
+, height(height)
+, channels(channels)
+{}
+
+kdr::img::Image::~Image()
+{
+  this->_reset();
+}
+
+kdr::img::Image::Image(kdr::img::Image&& other)
+{
+  *this = std::move(other);
+}
+
+kdr::img::Image& kdr::img::Image::operator=(kdr::img::Image&& other)
+{
+  if (this == &other) return *this;
+
+  this->_reset();
+  this->data     = other.data;
+  this->width    = other.width;
+  this->height   = other.height;
+  this->channels = other.channels;
+  this->owner    = other.owner;
+
+  other.data  = NULL;
+  other.owner = false;
+  other._reset();
+  return *this;
+}
+
+void kdr::img::Image::_reset()
+{
+  if (this->owner)
+  {
+    delete[] this->data;
+  }
+  this->data     = NULL;
+  this->width    = 0;
+  this->height   = 0;
+  this->channels = 0;
+  this->owner    = false;
+}
+
+GLubyte* kdr::img::ScratchAllocator::allocate(const size_t size)
+{
+  if (size > this->capacity)
+  {
+    // Drop the old memory first so both are never held at once
+    this->buffer.reset();
+    this->buffer.reset(new GLubyte[size]);
+    this->capacity = size;
+  }
+  return this->buffer.get();
+}
+
+void kdr::img::ScratchAllocator::release()
+{
+  this->buffer.reset();
+  this->capacity = 0;
+}
+
+bool kdr::img::decodePNG(
+  const std::string& pngPath,
+  const uint8_t* bytes,
+  const size_t size,
+  const bool isRGBA,
+  const std::function<GLubyte*(int width, int height, int channels)>& getBuffer
+)
+{
+  PNGSource source {(const char*)bytes, size, 8};
+  if (source.size < source.position || png_sig_cmp((png_const_bytep)source.data, 0, 8) != 0)
+  {
+    std::cerr << "Invalid PNG signature (" << pngPath << ")!\n";
+    return false;
+  }
 
-  pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
   if (pngPtr == NULL)
   {
     std::cerr << "Failed to create a read struct for a PNG!\n";
-    fclose(file);
     return false;
   }
 
-  infoPtr = png_create_info_struct(pngPtr);
+  png_infop infoPtr = png_create_info_struct(pngPtr);
   if (infoPtr == NULL)
   {
     std::cerr << "Failed to create an info struct for a PNG!\n";
-    fclose(file);
     png_destroy_read_struct(&pngPtr, NULL, NULL);
     return false;
   }
 
   if (setjmp(png_jmpbuf(pngPtr)))
   {
-    fclose(file);
-    png_destroy_read_struct(&pngPtr, NULL, NULL);
+    png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
     return false;
   }
 
-  png_init_io(pngPtr, file);
-  png_set_sig_bytes(pngPtr, sigRead);
+  png_set_read_fn(pngPtr, &source, readPNGSource);
+  png_set_sig_bytes(pngPtr, 8);
+  png_read_info(pngPtr, infoPtr);
+
+  png_set_strip_16(pngPtr);
+  png_set_packing(pngPtr);
+  png_set_expand(pngPtr);
+  if (isRGBA)
+  {
+    png_set_gray_to_rgb(pngPtr);
+    png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+  }
+  const int passCount = png_set_interlace_handling(pngPtr);
+  png_read_update_info(pngPtr, infoPtr);
+
+  const int    width    = png_get_image_width(pngPtr, infoPtr);
+  const int    height   = png_get_image_height(pngPtr, infoPtr);
+  const int    channels = png_get_channels(pngPtr, infoPtr);
+  const size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
 
-  png_read_png(
-    pngPtr,
-    infoPtr,
-    PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND,
-    NULL
-  );
-  png_uint_32 width;
-  png_uint_32 height;
+  GLubyte* pixels = getBuffer(width, height, channels);
+  if (pixels == NULL)
+  {
+    png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+    return false;
+  }
 
-  png_get_IHDR(pngPtr, infoPtr, &width, &height, NULL, NULL, NULL, NULL, NULL);
-  imgWidth = width;
-  imgHeight = height;
+  // Interlaced images refine the same rows on every pass
+  for (int pass = 0; pass < passCount; pass++)
+  {
+    for (int y = 0; y < height; y++)
+    {
+      png_read_row(pngPtr, pixels + rowBytes * (height - 1 - y), NULL);
+    }
+  }
+  png_read_end(pngPtr, NULL);
 
-  unsigned int rowBytes = png_get_rowbytes(pngPtr, infoPtr);
-  *data = (unsigned char*)malloc(rowBytes * imgHeight);
-  png_bytepp rowPointers = png_get_rows(pngPtr, infoPtr);
+  png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+  return true;
+}
 
-  for (int i = 0; i < imgHeight; i++)
+bool kdr::img::loadPNG(const std::string& pngPath, kdr::img::Image& image, const bool isRGBA, kdr::img::ScratchAllocator* scratch)
+{
+  image = kdr::img::Image();
+  const bool isLoaded = readPNG(pngPath, isRGBA, [&image, scratch](int width, int height, int channels) {
+    if (scratch != NULL)
+    {
+      image = kdr::img::Image(scratch->allocate((size_t)width * height * channels), width, height, channels);
+    }
+    else
+    {
+      image = kdr::img::Image(width, height, channels);
+    }
+    return image.getData();
+  });
+  // libpng can fail after the pixels are allocated, leaving them partly decoded
+  if (!isLoaded)
   {
-    memcpy(*data + (rowBytes * (imgHeight - 1 - i)), rowPointers[i], rowBytes);
+    image = kdr::img::Image();
   }
+  return isLoaded;
+}
 
-  fclose(file);
-  png_destroy_read_struct(&pngPtr, NULL, NULL);
+bool kdr::img::loadPNG(const std::string& pngPath, GLubyte* buffer, const size_t capacity, kdr::img::Image& image, const bool isRGBA)
+{
+  image = kdr::img::Image();
+  const bool isLoaded = readPNG(pngPath, isRGBA, [&](int width, int height, int channels) -> GLubyte* {
+    if ((size_t)width * height * channels > capacity)
+    {
+      std::cerr << "PNG does not fit its buffer (" << pngPath << ")!\n";
+      return NULL;
+    }
+    image = kdr::img::Image(buffer, width, height, channels);
+    return buffer;
+  });
+  if (!isLoaded)
+  {
+    image = kdr::img::Image();
+  }
+  return isLoaded;
+}
+
+bool kdr::img::loadFromPNG(const std::string& pngPath, GLubyte** data, int& imgWidth, int& imgHeight)
+{
+  int channels {0};
+  return kdr::img::loadFromPNG(pngPath, data, imgWidth, imgHeight, channels);
+}
+
+bool kdr::img::loadFromPNG(const std::string& pngPath, GLubyte** data, int& imgWidth, int& imgHeight, int& channels)
+{
+  *data = NULL;
+  const bool isLoaded = readPNG(pngPath, false, [&](int width, int height, int pixelChannels) {
+    imgWidth  = width;
+    imgHeight = height;
+    channels  = pixelChannels;
+    *data = (GLubyte*)malloc((size_t)width * height * pixelChannels);
+    return *data;
+  });
+  if (!isLoaded)
+  {
+    free(*data);
+    *data = NULL;
+  }
+  return isLoaded;
+}
+
+bool kdr::img::getPNGSize(const std::string& pngPath, int& imgWidth, int& imgHeight)
+{
+  // 8-byte signature, then the IHDR chunk: length, type, big-endian width and height
+  kdr::file::ChunkReader file(24);
+  std::string_view       chunk;
+  if (!file.open(pngPath) || !file.read(chunk))
+  {
+    std::cerr << "Failed to open file (" << pngPath << ")!\n";
+    return false;
+  }
+
+  const png_byte* header = (const png_byte*)chunk.data();
+  if (chunk.size() < 24 || png_sig_cmp(header, 0, 8) != 0 || memcmp(header + 12, "IHDR", 4) != 0)
+  {
+    std::cerr << "Invalid PNG header (" << pngPath << ")!\n";
+    return false;
+  }
 
+  imgWidth  = png_get_uint_31(NULL, header + 16);
+  imgHeight = png_get_uint_31(NULL, header + 20);
   return true;
 }
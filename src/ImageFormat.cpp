@@ -0,0 +1,460 @@
+#include "Kedarium/ImageFormat.hpp"
+
+#include <string.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "Kedarium/File.hpp"
+#include "Kedarium/Pixel.hpp"
+
+using GetBuffer = std::function<GLubyte*(int width, int height, int channels)>;
+
+// PNG: 8-byte signature, then the IHDR chunk: length, type, big-endian width and height
+static constexpr size_t PNG_HEADER_SIZE {24};
+
+// QOI: "qoif", big-endian width and height, channels, color space
+static constexpr size_t  QOI_HEADER_SIZE  {14};
+static constexpr size_t  QOI_PADDING_SIZE {8};
+static constexpr uint8_t QOI_OP_INDEX     {0x00};
+static constexpr uint8_t QOI_OP_DIFF      {0x40};
+static constexpr uint8_t QOI_OP_LUMA      {0x80};
+static constexpr uint8_t QOI_OP_RUN       {0xc0};
+static constexpr uint8_t QOI_OP_RGB       {0xfe};
+static constexpr uint8_t QOI_OP_RGBA      {0xff};
+static constexpr uint8_t QOI_MASK         {0xc0};
+// Largest image the QOI specification allows
+static constexpr uint64_t QOI_MAX_PIXELS  {400000000};
+
+// Raw: "KRAW", then width, height and channels as little-endian uint32
+static constexpr size_t RAW_HEADER_SIZE {16};
+
+static uint32_t readBigEndian(const uint8_t* bytes)
+{
+  return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+static void writeBigEndian(std::string& bytes, const uint32_t value)
+{
+  bytes += (char)(value >> 24);
+  bytes += (char)(value >> 16);
+  bytes += (char)(value >> 8);
+  bytes += (char)value;
+}
+
+static kdr::img::ImageFormat detectFormat(const uint8_t* bytes, const size_t size)
+{
+  if (size >= 8 && png_sig_cmp(bytes, 0, 8) == 0) return kdr::img::ImageFormat::PNG;
+  if (size >= 4 && memcmp(bytes, "qoif", 4) == 0) return kdr::img::ImageFormat::QOI;
+  if (size >= 4 && memcmp(bytes, "KRAW", 4) == 0) return kdr::img::ImageFormat::Raw;
+  return kdr::img::ImageFormat::Unknown;
+}
+
+static int getQOIHash(const uint8_t pixel[4])
+{
+  return (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+}
+
+/**
+ * Copies pixels between channel counts. Gray is copied to RGB and missing alpha is opaque.
+ */
+static void convertChannels(const uint8_t* input, const int inputChannels, uint8_t* output, const int outputChannels, const size_t pixelCount)
+{
+  if (inputChannels == outputChannels)
+  {
+    memcpy(output, input, pixelCount * inputChannels);
+    return;
+  }
+  if (inputChannels == 3 && outputChannels == 4)
+  {
+    kdr::img::expandRGBToRGBA(input, output, pixelCount);
+    return;
+  }
+
+  const bool isGray   = inputChannels < 3;
+  const bool hasAlpha = inputChannels % 2 == 0;
+  for (size_t i = 0; i < pixelCount; i++)
+  {
+    const uint8_t* source = input + i * inputChannels;
+    uint8_t*       target = output + i * outputChannels;
+    target[0] = source[0];
+    target[1] = isGray ? source[0] : source[1];
+    target[2] = isGray ? source[0] : source[2];
+    if (outputChannels == 4)
+    {
+      target[3] = hasAlpha ? source[inputChannels - 1] : 0xff;
+    }
+  }
+}
+
+/**
+ * Decodes a QOI image, last row first so the image ends up bottom row first.
+ */
+static bool readQOI(const std::string& path, const uint8_t* bytes, const size_t size, const bool isRGBA, const GetBuffer& getBuffer)
+{
+  const uint32_t width    = size >= QOI_HEADER_SIZE ? readBigEndian(bytes + 4) : 0;
+  const uint32_t height   = size >= QOI_HEADER_SIZE ? readBigEndian(bytes + 8) : 0;
+  const int      channels = size >= QOI_HEADER_SIZE ? bytes[12] : 0;
+  if (
+    size < QOI_HEADER_SIZE + QOI_PADDING_SIZE ||
+    width == 0 ||
+    height == 0 ||
+    (uint64_t)width * height > QOI_MAX_PIXELS ||
+    (channels != 3 && channels != 4)
+  )
+  {
+    std::cerr << "Invalid QOI header (" << path << ")!\n";
+    return false;
+  }
+
+  const int outputChannels = isRGBA ? 4 : channels;
+  GLubyte* pixels = getBuffer((int)width, (int)height, outputChannels);
+  if (pixels == NULL) return false;
+
+  uint8_t index[64][4] {};
+  uint8_t pixel[4] {0, 0, 0, 0xff};
+  int     run {0};
+  size_t  position = QOI_HEADER_SIZE;
+  // Ops read at most 4 bytes past their first, which the end padding covers
+  const size_t end = size - QOI_PADDING_SIZE;
+  for (uint32_t y = 0; y < height; y++)
+  {
+    uint8_t* row = pixels + (size_t)width * outputChannels * (height - 1 - y);
+    for (uint32_t x = 0; x < width; x++)
+    {
+      if (run > 0)
+      {
+        run--;
+      }
+      else if (position < end)
+      {
+        const uint8_t op = bytes[position++];
+        if (op == QOI_OP_RGB)
+        {
+          memcpy(pixel, bytes + position, 3);
+          position += 3;
+        }
+        else if (op == QOI_OP_RGBA)
+        {
+          memcpy(pixel, bytes + position, 4);
+          position += 4;
+        }
+        else if ((op & QOI_MASK) == QOI_OP_INDEX)
+        {
+          memcpy(pixel, index[op], 4);
+        }
+        else if ((op & QOI_MASK) == QOI_OP_DIFF)
+        {
+          pixel[0] += ((op >> 4) & 0x03) - 2;
+          pixel[1] += ((op >> 2) & 0x03) - 2;
+          pixel[2] += (op & 0x03) - 2;
+        }
+        else if ((op & QOI_MASK) == QOI_OP_LUMA)
+        {
+          const uint8_t next  = bytes[position++];
+          const int     green = (op & 0x3f) - 32;
+          pixel[0] += green - 8 + ((next >> 4) & 0x0f);
+          pixel[1] += green;
+          pixel[2] += green - 8 + (next & 0x0f);
+        }
+        else
+        {
+          run = op & 0x3f;
+        }
+        memcpy(index[getQOIHash(pixel)], pixel, 4);
+      }
+      // Constant sizes, so the copies compile to single stores
+      if (outputChannels == 4) memcpy(row + (size_t)x * 4, pixel, 4);
+      else memcpy(row + (size_t)x * 3, pixel, 3);
+    }
+  }
+  return true;
+}
+
+/**
+ * Copies a raw image, expanding its channels if needed.
+ */
+static bool readRawImage(const std::string& path, const uint8_t* bytes, const size_t size, const bool isRGBA, const GetBuffer& getBuffer)
+{
+  // Magic, width, height, channels
+  uint32_t header[4] {0, 0, 0, 0};
+  if (size >= RAW_HEADER_SIZE) memcpy(header, bytes, RAW_HEADER_SIZE);
+  if (
+    size < RAW_HEADER_SIZE ||
+    header[1] == 0 || header[1] > INT32_MAX ||
+    header[2] == 0 || header[2] > INT32_MAX ||
+    header[3] == 0 || header[3] > 4 ||
+    (uint64_t)header[1] * header[2] > (size - RAW_HEADER_SIZE) / header[3]
+  )
+  {
+    std::cerr << "Invalid raw image header (" << path << ")!\n";
+    return false;
+  }
+
+  const int outputChannels = isRGBA ? 4 : (int)header[3];
+  GLubyte* pixels = getBuffer((int)header[1], (int)header[2], outputChannels);
+  if (pixels == NULL) return false;
+
+  convertChannels(bytes + RAW_HEADER_SIZE, (int)header[3], pixels, outputChannels, (size_t)header[1] * header[2]);
+  return true;
+}
+
+/**
+ * Decodes an image of any known format into the memory returned by getBuffer.
+ */
+static bool readImage(const std::string& path, const bool isRGBA, const GetBuffer& getBuffer)
+{
+  // Opened once: packed files are inflated on open, so the decoders share the view
+  kdr::file::FileView file;
+  if (!file.open(path))
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+
+  const uint8_t* bytes = (const uint8_t*)file.getData();
+  switch (detectFormat(bytes, file.getSize()))
+  {
+    case kdr::img::ImageFormat::PNG:
+      return kdr::img::decodePNG(path, bytes, file.getSize(), isRGBA, getBuffer);
+    case kdr::img::ImageFormat::QOI:
+      return readQOI(path, bytes, file.getSize(), isRGBA, getBuffer);
+    case kdr::img::ImageFormat::Raw:
+      return readRawImage(path, bytes, file.getSize(), isRGBA, getBuffer);
+    default:
+      std::cerr << "Unknown image format (" << path << ")!\n";
+      return false;
+  }
+}
+
+static bool writeFile(const std::string& path, const std::string& header, const uint8_t* data, const size_t size)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+  file.write(header.data(), header.size());
+  file.write((const char*)data, size);
+  if (!file)
+  {
+    std::cerr << "Failed to write file (" << path << ")!\n";
+    return false;
+  }
+  return true;
+}
+
+kdr::img::ImageFormat kdr::img::getImageFormat(const std::string& path)
+{
+  // Only the signature is read
+  kdr::file::ChunkReader file(8);
+  std::string_view       signature;
+  if (!file.open(path) || !file.read(signature)) return kdr::img::ImageFormat::Unknown;
+  return detectFormat((const uint8_t*)signature.data(), signature.size());
+}
+
+bool kdr::img::getImageSize(const std::string& path, int& width, int& height)
+{
+  // The PNG header is the longest of the three
+  kdr::file::ChunkReader file(PNG_HEADER_SIZE);
+  std::string_view       header;
+  if (!file.open(path) || !file.read(header))
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+
+  const uint8_t* bytes = (const uint8_t*)header.data();
+  switch (detectFormat(bytes, header.size()))
+  {
+    case kdr::img::ImageFormat::PNG:
+    {
+      // Read from this header rather than through getPNGSize(), which would open the file again
+      if (header.size() < PNG_HEADER_SIZE || memcmp(bytes + 12, "IHDR", 4) != 0) break;
+      const uint32_t size[2] {readBigEndian(bytes + 16), readBigEndian(bytes + 20)};
+      if (size[0] > INT32_MAX || size[1] > INT32_MAX) break;
+      width  = (int)size[0];
+      height = (int)size[1];
+      return width > 0 && height > 0;
+    }
+    case kdr::img::ImageFormat::QOI:
+      if (header.size() < QOI_HEADER_SIZE) break;
+      width  = (int)readBigEndian(bytes + 4);
+      height = (int)readBigEndian(bytes + 8);
+      return width > 0 && height > 0;
+    case kdr::img::ImageFormat::Raw:
+    {
+      if (header.size() < RAW_HEADER_SIZE) break;
+      uint32_t size[2];
+      memcpy(size, bytes + 4, sizeof(size));
+      width  = (int)size[0];
+      height = (int)size[1];
+      return width > 0 && height > 0;
+    }
+    default:
+      break;
+  }
+  std::cerr << "Invalid image header (" << path << ")!\n";
+  return false;
+}
+
+bool kdr::img::loadImage(const std::string& path, kdr::img::Image& image, const bool isRGBA, kdr::img::ScratchAllocator* scratch)
+{
+  image = kdr::img::Image();
+  const GetBuffer getBuffer = [&image, scratch](int width, int height, int channels) {
+    if (scratch != NULL)
+    {
+      image = kdr::img::Image(scratch->allocate((size_t)width * height * channels), width, height, channels);
+    }
+    else
+    {
+      image = kdr::img::Image(width, height, channels);
+    }
+    return image.getData();
+  };
+  const bool isLoaded = readImage(path, isRGBA, getBuffer);
+  // Decoders can fail after the pixels are allocated, leaving them partly decoded
+  if (!isLoaded)
+  {
+    image = kdr::img::Image();
+  }
+  return isLoaded;
+}
+
+bool kdr::img::loadImage(const std::string& path, GLubyte* buffer, const size_t capacity, kdr::img::Image& image, const bool isRGBA)
+{
+  image = kdr::img::Image();
+  const GetBuffer getBuffer = [&](int width, int height, int channels) -> GLubyte* {
+    if ((size_t)width * height * channels > capacity)
+    {
+      std::cerr << "Image does not fit its buffer (" << path << ")!\n";
+      return NULL;
+    }
+    image = kdr::img::Image(buffer, width, height, channels);
+    return buffer;
+  };
+  const bool isLoaded = readImage(path, isRGBA, getBuffer);
+  if (!isLoaded)
+  {
+    image = kdr::img::Image();
+  }
+  return isLoaded;
+}
+
+bool kdr::img::saveQOI(const std::string& path, const kdr::img::Image& image)
+{
+  const int    width    = image.getWidth();
+  const int    height   = image.getHeight();
+  const size_t count    = (size_t)width * height;
+  const int    channels = image.getChannels() % 2 == 0 ? 4 : 3;
+  if (image.isEmpty() || count > QOI_MAX_PIXELS)
+  {
+    std::cerr << "Invalid image for QOI (" << path << ")!\n";
+    return false;
+  }
+
+  std::vector<uint8_t> converted;
+  const uint8_t*       pixels = image.getData();
+  if (image.getChannels() != channels)
+  {
+    converted.resize(count * channels);
+    convertChannels(pixels, image.getChannels(), converted.data(), channels, count);
+    pixels = converted.data();
+  }
+
+  std::string bytes {"qoif"};
+  bytes.reserve(QOI_HEADER_SIZE + count * (channels + 1) + QOI_PADDING_SIZE);
+  writeBigEndian(bytes, width);
+  writeBigEndian(bytes, height);
+  bytes += (char)channels;
+  // sRGB color, linear alpha
+  bytes += (char)0;
+
+  uint8_t index[64][4] {};
+  uint8_t previous[4] {0, 0, 0, 0xff};
+  uint8_t pixel[4]    {0, 0, 0, 0xff};
+  int     run {0};
+  size_t  written {0};
+  // Top row first
+  for (int y = height - 1; y >= 0; y--)
+  {
+    const uint8_t* row = pixels + (size_t)width * channels * y;
+    for (int x = 0; x < width; x++)
+    {
+      memcpy(pixel, row + (size_t)x * channels, channels);
+      written++;
+
+      if (memcmp(pixel, previous, 4) == 0)
+      {
+        run++;
+        if (run == 62 || written == count)
+        {
+          bytes += (char)(QOI_OP_RUN | (run - 1));
+          run = 0;
+        }
+        continue;
+      }
+
+      if (run > 0)
+      {
+        bytes += (char)(QOI_OP_RUN | (run - 1));
+        run = 0;
+      }
+
+      const int hash = getQOIHash(pixel);
+      if (memcmp(index[hash], pixel, 4) == 0)
+      {
+        bytes += (char)(QOI_OP_INDEX | hash);
+      }
+      else
+      {
+        memcpy(index[hash], pixel, 4);
+        const int8_t red   = (int8_t)(pixel[0] - previous[0]);
+        const int8_t green = (int8_t)(pixel[1] - previous[1]);
+        const int8_t blue  = (int8_t)(pixel[2] - previous[2]);
+        const int8_t greenRed  = (int8_t)(red - green);
+        const int8_t greenBlue = (int8_t)(blue - green);
+
+        if (pixel[3] != previous[3])
+        {
+          bytes += (char)QOI_OP_RGBA;
+          bytes.append((const char*)pixel, 4);
+        }
+        else if (red >= -2 && red <= 1 && green >= -2 && green <= 1 && blue >= -2 && blue <= 1)
+        {
+          bytes += (char)(QOI_OP_DIFF | (red + 2) << 4 | (green + 2) << 2 | (blue + 2));
+        }
+        else if (greenRed >= -8 && greenRed <= 7 && green >= -32 && green <= 31 && greenBlue >= -8 && greenBlue <= 7)
+        {
+          bytes += (char)(QOI_OP_LUMA | (green + 32));
+          bytes += (char)((greenRed + 8) << 4 | (greenBlue + 8));
+        }
+        else
+        {
+          bytes += (char)QOI_OP_RGB;
+          bytes.append((const char*)pixel, 3);
+        }
+      }
+      memcpy(previous, pixel, 4);
+    }
+  }
+
+  static const uint8_t padding[QOI_PADDING_SIZE] {0, 0, 0, 0, 0, 0, 0, 1};
+  return writeFile(path, bytes, padding, sizeof(padding));
+}
+
+bool kdr::img::saveRawImage(const std::string& path, const kdr::img::Image& image)
+{
+  if (image.isEmpty())
+  {
+    std::cerr << "Invalid image for a raw image (" << path << ")!\n";
+    return false;
+  }
+
+  const uint32_t size[3] {(uint32_t)image.getWidth(), (uint32_t)image.getHeight(), (uint32_t)image.getChannels()};
+  std::string header {"KRAW"};
+  header.append((const char*)size, sizeof(size));
+  return writeFile(path, header, image.getData(), image.getSize());
+}
@@ -0,0 +1,221 @@
+#include "Kedarium/Mipmap.hpp"
+
+#include <math.h>
+#include <stddef.h>
+
+#include "Kedarium/Pixel.hpp"
+#include "Kedarium/Simd.hpp"
+
+// Kaiser filter: taps per dimension and window shape
+static constexpr int   KAISER_TAPS  {8};
+static constexpr float KAISER_ALPHA {4.f};
+
+static float besselI0(const float x)
+{
+  float sum  {1.f};
+  float term {1.f};
+  for (int k = 1; k < 32 && term > sum * 1e-7f; k++)
+  {
+    term *= (x / (2.f * k)) * (x / (2.f * k));
+    sum  += term;
+  }
+  return sum;
+}
+
+/**
+ * Gets the weights of the source texels 2x + first to 2x + first + count - 1
+ * making up the destination texel x. A dimension that is not halved (already
+ * 1 texel) is copied through.
+ */
+static void getTaps(const kdr::img::MipFilter filter, const bool isHalved, int& first, int& count, float weights[KAISER_TAPS])
+{
+  if (!isHalved)
+  {
+    first = 0;
+    count = 1;
+    weights[0] = 1.f;
+    return;
+  }
+  if (filter == kdr::img::MipFilter::Box)
+  {
+    first = 0;
+    count = 2;
+    weights[0] = weights[1] = 0.5f;
+    return;
+  }
+
+  // Sinc with half the source bandwidth, windowed over 4 destination texels
+  first = 1 - KAISER_TAPS / 2;
+  count = KAISER_TAPS;
+  float sum {0.f};
+  for (int k = 0; k < KAISER_TAPS; k++)
+  {
+    const float distance = first + k - 0.5f;
+    const float x = distance * 0.5f * (float)M_PI;
+    const float sinc = sinf(x) / x;
+    const float window = distance / (KAISER_TAPS / 2);
+    weights[k] = sinc * besselI0(KAISER_ALPHA * sqrtf(1.f - window * window)) / besselI0(KAISER_ALPHA);
+    sum += weights[k];
+  }
+  for (int k = 0; k < KAISER_TAPS; k++)
+  {
+    weights[k] /= sum;
+  }
+}
+
+/**
+ * Adds a weighted source row to a destination row.
+ */
+static void accumulateRow(float* output, const float* input, const float weight, const size_t count)
+{
+  size_t i = 0;
+#if defined(KDR_SIMD_AVX)
+  const __m256 scale = _mm256_set1_ps(weight);
+  for (; i + 8 <= count; i += 8)
+  {
+    _mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_loadu_ps(output + i), _mm256_mul_ps(scale, _mm256_loadu_ps(input + i))));
+  }
+#elif defined(KDR_SIMD_SSE)
+  const __m128 scale = _mm_set1_ps(weight);
+  for (; i + 4 <= count; i += 4)
+  {
+    _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(scale, _mm_loadu_ps(input + i))));
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 4 <= count; i += 4)
+  {
+    vst1q_f32(output + i, vaddq_f32(vld1q_f32(output + i), vmulq_n_f32(vld1q_f32(input + i), weight)));
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    output[i] += weight * input[i];
+  }
+}
+
+/**
+ * Filters a row of RGBA texels down to its destination width.
+ */
+static void filterRow(
+  float* output,
+  const float* input,
+  const int inputWidth,
+  const int outputWidth,
+  const int first,
+  const int count,
+  const float* weights
+)
+{
+  for (int x = 0; x < outputWidth; x++)
+  {
+#if defined(KDR_SIMD_SSE)
+    __m128 sum = _mm_setzero_ps();
+#elif defined(KDR_SIMD_NEON)
+    float32x4_t sum = vdupq_n_f32(0.f);
+#else
+    float sum[4] {0.f, 0.f, 0.f, 0.f};
+#endif
+    for (int k = 0; k < count; k++)
+    {
+      int source = x * 2 + first + k;
+      source = source < 0 ? 0 : (source >= inputWidth ? inputWidth - 1 : source);
+      const float* texel = input + (size_t)source * 4;
+#if defined(KDR_SIMD_SSE)
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(texel)));
+#elif defined(KDR_SIMD_NEON)
+      sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(texel), weights[k]));
+#else
+      for (int c = 0; c < 4; c++)
+      {
+        sum[c] += weights[k] * texel[c];
+      }
+#endif
+    }
+#if defined(KDR_SIMD_SSE)
+    _mm_storeu_ps(output + (size_t)x * 4, sum);
+#elif defined(KDR_SIMD_NEON)
+    vst1q_f32(output + (size_t)x * 4, sum);
+#else
+    for (int c = 0; c < 4; c++)
+    {
+      output[(size_t)x * 4 + c] = sum[c];
+    }
+#endif
+  }
+}
+
+int kdr::img::getMipLevelCount(int width, int height)
+{
+  int count {1};
+  while (width > 1 || height > 1)
+  {
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+    count++;
+  }
+  return count;
+}
+
+void kdr::img::generateMipChain(
+  const uint8_t* pixels,
+  int width,
+  int height,
+  const kdr::img::MipFilter filter,
+  const bool isSRGB,
+  std::vector<std::vector<uint8_t>>& levels
+)
+{
+  const size_t size = (size_t)width * height * 4;
+
+  levels.clear();
+  levels.reserve(kdr::img::getMipLevelCount(width, height));
+  levels.emplace_back(pixels, pixels + size);
+
+  std::vector<float> current(size);
+  kdr::img::decodePixels(pixels, current.data(), size / 4, isSRGB);
+
+  std::vector<float> vertical;
+  std::vector<float> next;
+  int   first {0};
+  int   count {0};
+  float weights[KAISER_TAPS];
+  while (width > 1 || height > 1)
+  {
+    const int nextWidth  = width  > 1 ? width  / 2 : 1;
+    const int nextHeight = height > 1 ? height / 2 : 1;
+    const size_t rowSize = (size_t)width * 4;
+
+    // Columns first, whole rows at a time
+    vertical.assign(rowSize * nextHeight, 0.f);
+    getTaps(filter, height > 1, first, count, weights);
+    for (int y = 0; y < nextHeight; y++)
+    {
+      for (int k = 0; k < count; k++)
+      {
+        int source = y * 2 + first + k;
+        source = source < 0 ? 0 : (source >= height ? height - 1 : source);
+        accumulateRow(vertical.data() + rowSize * y, current.data() + rowSize * source, weights[k], rowSize);
+      }
+    }
+
+    next.resize((size_t)nextWidth * nextHeight * 4);
+    getTaps(filter, width > 1, first, count, weights);
+    for (int y = 0; y < nextHeight; y++)
+    {
+      filterRow(next.data() + (size_t)nextWidth * 4 * y, vertical.data() + rowSize * y, width, nextWidth, first, count, weights);
+    }
+
+    // The negative lobes of the Kaiser filter can overshoot, and the next level is filtered from the clamped one
+    for (float& value : next)
+    {
+      value = value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+    }
+    levels.emplace_back(next.size());
+    kdr::img::encodePixels(next.data(), levels.back().data(), next.size() / 4, isSRGB);
+
+    current.swap(next);
+    width  = nextWidth;
+    height = nextHeight;
+  }
+}
@@ -0,0 +1,336 @@
+#include "Kedarium/Pack.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#include "Kedarium/File.hpp"
+
+// "KPAK"
+static constexpr uint32_t PACK_MAGIC   {0x4b41504b};
+static constexpr uint32_t PACK_VERSION {1};
+// Deflate expands its input at most 1032 times
+static constexpr uint64_t ZLIB_MAX_RATIO {1032};
+
+/**
+ * Header at the start of a pack.
+ */
+struct PackHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t nameTableSize;
+  uint64_t tocOffset;
+  uint64_t nameTableOffset;
+};
+
+static std::vector<std::unique_ptr<kdr::file::Pack>> mountedPacks;
+static std::mutex                                    mountMutex;
+
+static uint64_t hashPath(const std::string& path)
+{
+  // 64-bit FNV-1a
+  uint64_t hash {0xcbf29ce484222325ull};
+  for (const char c : path)
+  {
+    hash ^= (unsigned char)c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+kdr::file::Pack::~Pack()
+{
+  this->close();
+}
+
+bool kdr::file::Pack::open(const std::string& path)
+{
+  this->close();
+
+  const int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0 || (size_t)status.st_size < sizeof(PackHeader))
+  {
+    std::cerr << "Invalid pack (" << path << ")!\n";
+    ::close(file);
+    return false;
+  }
+
+  // The mapping stays valid once the descriptor is closed
+  void* mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file);
+  if (mapping == MAP_FAILED)
+  {
+    std::cerr << "Failed to map pack (" << path << ")!\n";
+    return false;
+  }
+  this->mapping = mapping;
+  this->size    = status.st_size;
+
+  const PackHeader& header = *(const PackHeader*)mapping;
+  const uint64_t    tocSize = (uint64_t)header.entryCount * sizeof(kdr::file::PackEntry);
+  if (
+    header.magic != PACK_MAGIC ||
+    header.version != PACK_VERSION ||
+    header.tocOffset % alignof(kdr::file::PackEntry) != 0 ||
+    header.tocOffset > this->size ||
+    tocSize > this->size - header.tocOffset ||
+    header.nameTableOffset > this->size ||
+    header.nameTableSize > this->size - header.nameTableOffset
+  )
+  {
+    std::cerr << "Invalid pack header (" << path << ")!\n";
+    this->close();
+    return false;
+  }
+  this->entries    = (const kdr::file::PackEntry*)((const char*)mapping + header.tocOffset);
+  this->entryCount = header.entryCount;
+  this->names      = (const char*)mapping + header.nameTableOffset;
+
+  for (size_t i = 0; i < this->entryCount; i++)
+  {
+    const kdr::file::PackEntry& entry = this->entries[i];
+    if (
+      entry.offset > this->size ||
+      entry.storedSize > this->size - entry.offset ||
+      entry.nameOffset > header.nameTableSize ||
+      entry.nameLength > header.nameTableSize - entry.nameOffset ||
+      entry.compression > kdr::file::PackCompression::Zlib ||
+      (entry.compression == kdr::file::PackCompression::None && entry.storedSize != entry.size) ||
+      // Bounds the buffer read() inflates into
+      (entry.compression == kdr::file::PackCompression::Zlib && entry.size > entry.storedSize * ZLIB_MAX_RATIO)
+    )
+    {
+      std::cerr << "Invalid pack entry " << i << " (" << path << ")!\n";
+      this->close();
+      return false;
+    }
+  }
+  return true;
+}
+
+void kdr::file::Pack::close()
+{
+  if (this->mapping != NULL)
+  {
+    munmap(this->mapping, this->size);
+  }
+  this->mapping    = NULL;
+  this->size       = 0;
+  this->entries    = NULL;
+  this->entryCount = 0;
+  this->names      = NULL;
+}
+
+const kdr::file::PackEntry* kdr::file::Pack::find(const std::string& path) const
+{
+  const std::string name = kdr::file::normalizePath(path);
+  const uint64_t    hash = hashPath(name);
+
+  const kdr::file::PackEntry* end   = this->entries + this->entryCount;
+  const kdr::file::PackEntry* entry = std::lower_bound(
+    this->entries,
+    end,
+    hash,
+    [](const kdr::file::PackEntry& entry, const uint64_t hash) { return entry.hash < hash; }
+  );
+  // Entries sharing a hash are adjacent
+  for (; entry != end && entry->hash == hash; entry++)
+  {
+    if (name.compare(0, std::string::npos, this->names + entry->nameOffset, entry->nameLength) == 0)
+    {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+bool kdr::file::Pack::read(const kdr::file::PackEntry& entry, const char*& data, std::string& buffer) const
+{
+  if (entry.compression == kdr::file::PackCompression::None)
+  {
+    data = this->getStoredData(entry);
+    return true;
+  }
+
+  buffer.resize(entry.size);
+  uLongf size = entry.size;
+  const int result = uncompress(
+    (Bytef*)&buffer[0],
+    &size,
+    (const Bytef*)this->getStoredData(entry),
+    entry.storedSize
+  );
+  if (result != Z_OK || size != entry.size)
+  {
+    std::cerr << "Failed to inflate pack entry (" << std::string(this->names + entry.nameOffset, entry.nameLength) << ")!\n";
+    return false;
+  }
+  data = buffer.data();
+  return true;
+}
+
+std::string kdr::file::normalizePath(const std::string& path)
+{
+  return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool kdr::file::writePack(const std::string& packPath, const std::vector<std::string>& filePaths, const bool compress)
+{
+  std::vector<kdr::file::PackEntry> entries(filePaths.size());
+  std::vector<std::string>          names(filePaths.size());
+  for (size_t i = 0; i < filePaths.size(); i++)
+  {
+    names[i] = kdr::file::normalizePath(filePaths[i]);
+    entries[i].hash = hashPath(names[i]);
+    // Indexes the paths until the entries are sorted
+    entries[i].reserved = (uint32_t)i;
+  }
+  std::sort(entries.begin(), entries.end(), [&names](const kdr::file::PackEntry& a, const kdr::file::PackEntry& b) {
+    return a.hash != b.hash ? a.hash < b.hash : names[a.reserved] < names[b.reserved];
+  });
+
+  std::string nameTable;
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    const std::string& name = names[entries[i].reserved];
+    if (i > 0 && name == names[entries[i - 1].reserved])
+    {
+      std::cerr << "Duplicate pack entry (" << name << ")!\n";
+      return false;
+    }
+    entries[i].nameOffset = (uint32_t)nameTable.size();
+    entries[i].nameLength = (uint32_t)name.size();
+    nameTable += name;
+  }
+
+  std::ofstream pack(packPath, std::ios::binary | std::ios::trunc);
+  if (!pack.is_open())
+  {
+    std::cerr << "Failed to open file (" << packPath << ")!\n";
+    return false;
+  }
+
+  PackHeader header {
+    PACK_MAGIC,
+    PACK_VERSION,
+    (uint32_t)entries.size(),
+    (uint32_t)nameTable.size(),
+    sizeof(PackHeader),
+    sizeof(PackHeader) + entries.size() * sizeof(kdr::file::PackEntry),
+  };
+  // The table of contents is written once the data offsets are known
+  pack.write((const char*)&header, sizeof(header));
+  pack.write((const char*)entries.data(), entries.size() * sizeof(kdr::file::PackEntry));
+  pack.write(nameTable.data(), nameTable.size());
+
+  const char  padding[kdr::file::PACK_ALIGNMENT] {};
+  std::string compressed;
+  for (kdr::file::PackEntry& entry : entries)
+  {
+    const std::string& path = filePaths[entry.reserved];
+    // Mapped, so stored entries are written straight from the page cache
+    kdr::file::FileView file;
+    if (!file.open(path))
+    {
+      std::cerr << "Failed to open file (" << path << ")!\n";
+      return false;
+    }
+    const std::string_view data = file.getView();
+
+    entry.size        = data.size();
+    entry.storedSize  = data.size();
+    entry.compression = kdr::file::PackCompression::None;
+    entry.reserved    = 0;
+
+    // Only kept when it pays for inflating on every read
+    if (compress && !data.empty())
+    {
+      uLongf size = compressBound(data.size());
+      compressed.resize(size);
+      const int result = compress2(
+        (Bytef*)&compressed[0],
+        &size,
+        (const Bytef*)data.data(),
+        data.size(),
+        Z_BEST_COMPRESSION
+      );
+      if (result == Z_OK && size <= data.size() - data.size() / 8)
+      {
+        entry.storedSize  = size;
+        entry.compression = kdr::file::PackCompression::Zlib;
+      }
+    }
+
+    const uint64_t position = pack.tellp();
+    entry.offset = (position + kdr::file::PACK_ALIGNMENT - 1) / kdr::file::PACK_ALIGNMENT * kdr::file::PACK_ALIGNMENT;
+    pack.write(padding, entry.offset - position);
+    if (entry.compression == kdr::file::PackCompression::Zlib)
+    {
+      pack.write(compressed.data(), entry.storedSize);
+    }
+    else
+    {
+      pack.write(data.data(), data.size());
+    }
+  }
+
+  pack.seekp(header.tocOffset);
+  pack.write((const char*)entries.data(), entries.size() * sizeof(kdr::file::PackEntry));
+  if (!pack)
+  {
+    std::cerr << "Failed to write file (" << packPath << ")!\n";
+    return false;
+  }
+  return true;
+}
+
+bool kdr::file::mountPack(const std::string& packPath)
+{
+  std::unique_ptr<kdr::file::Pack> pack {new kdr::file::Pack};
+  if (!pack->open(packPath)) return false;
+
+  std::lock_guard<std::mutex> lock(mountMutex);
+  mountedPacks.push_back(std::move(pack));
+  return true;
+}
+
+void kdr::file::unmountPacks()
+{
+  std::lock_guard<std::mutex> lock(mountMutex);
+  mountedPacks.clear();
+}
+
+bool kdr::file::readPacked(const std::string& path, const char*& data, size_t& size, std::string& buffer)
+{
+  const kdr::file::Pack*      pack  {NULL};
+  const kdr::file::PackEntry* entry {NULL};
+  {
+    std::lock_guard<std::mutex> lock(mountMutex);
+    for (size_t i = mountedPacks.size(); i > 0 && entry == NULL; i--)
+    {
+      pack  = mountedPacks[i - 1].get();
+      entry = pack->find(path);
+    }
+  }
+  if (entry == NULL) return false;
+
+  // Packs are immutable once mapped, so reading needs no lock
+  size = entry->size;
+  return pack->read(*entry, data, buffer);
+}
@@ -0,0 +1,285 @@
+#include "Kedarium/Pixel.hpp"
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#include "Kedarium/Simd.hpp"
+
+// Entries of the linear to sRGB table, enough to tell every 8-bit sRGB value apart
+static constexpr int SRGB_TABLE_SIZE {4096};
+
+static const float* getLinearTable()
+{
+  static float table[256];
+  static const bool isFilled = []() {
+    for (int i = 0; i < 256; i++)
+    {
+      const float value = i / 255.f;
+      table[i] = value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+    }
+    return true;
+  }();
+  (void)isFilled;
+  return table;
+}
+
+static const uint8_t* getSRGBTable()
+{
+  static uint8_t table[SRGB_TABLE_SIZE];
+  static const bool isFilled = []() {
+    for (int i = 0; i < SRGB_TABLE_SIZE; i++)
+    {
+      const float value = (float)i / (SRGB_TABLE_SIZE - 1);
+      const float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.f / 2.4f) - 0.055f;
+      table[i] = (uint8_t)(encoded * 255.f + 0.5f);
+    }
+    return true;
+  }();
+  (void)isFilled;
+  return table;
+}
+
+/**
+ * Divides a product of two 8-bit values by 255, rounded to the nearest.
+ */
+static inline uint8_t divide255(const unsigned int product)
+{
+  const unsigned int value = product + 128;
+  return (uint8_t)((value + (value >> 8)) >> 8);
+}
+
+void kdr::img::expandRGBToRGBA(const uint8_t* input, uint8_t* output, const size_t pixelCount)
+{
+  size_t i = 0;
+#if defined(KDR_SIMD_SSE)
+  // 16 bytes are loaded for 4 pixels (12 bytes), so the last ones are left to the tail
+  const __m128i alpha = _mm_set1_epi32((int)0xff000000);
+  for (; i + 6 <= pixelCount; i += 4)
+  {
+    const __m128i rgb = _mm_loadu_si128((const __m128i*)(input + i * 3));
+    const __m128i low  = _mm_unpacklo_epi32(rgb, _mm_srli_si128(rgb, 3));
+    const __m128i high = _mm_unpacklo_epi32(_mm_srli_si128(rgb, 6), _mm_srli_si128(rgb, 9));
+    _mm_storeu_si128((__m128i*)(output + i * 4), _mm_or_si128(_mm_unpacklo_epi64(low, high), alpha));
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    const uint8x16x3_t rgb = vld3q_u8(input + i * 3);
+    uint8x16x4_t rgba;
+    rgba.val[0] = rgb.val[0];
+    rgba.val[1] = rgb.val[1];
+    rgba.val[2] = rgb.val[2];
+    rgba.val[3] = vdupq_n_u8(0xff);
+    vst4q_u8(output + i * 4, rgba);
+  }
+#endif
+
+  for (; i < pixelCount; i++)
+  {
+    output[i * 4]     = input[i * 3];
+    output[i * 4 + 1] = input[i * 3 + 1];
+    output[i * 4 + 2] = input[i * 3 + 2];
+    output[i * 4 + 3] = 0xff;
+  }
+}
+
+void kdr::img::swapRedBlue(const uint8_t* input, uint8_t* output, const size_t pixelCount)
+{
+  size_t i = 0;
+#if defined(KDR_SIMD_SSE)
+  const __m128i greenAlpha = _mm_set1_epi32((int)0xff00ff00);
+  const __m128i low        = _mm_set1_epi32(0xff);
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m128i pixels = _mm_loadu_si128((const __m128i*)(input + i * 4));
+    const __m128i red    = _mm_slli_epi32(_mm_and_si128(pixels, low), 16);
+    const __m128i blue   = _mm_and_si128(_mm_srli_epi32(pixels, 16), low);
+    _mm_storeu_si128((__m128i*)(output + i * 4), _mm_or_si128(_mm_and_si128(pixels, greenAlpha), _mm_or_si128(red, blue)));
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    uint8x16x4_t pixels = vld4q_u8(input + i * 4);
+    const uint8x16_t red = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = red;
+    vst4q_u8(output + i * 4, pixels);
+  }
+#endif
+
+  for (; i < pixelCount; i++)
+  {
+    const uint8_t red = input[i * 4];
+    output[i * 4]     = input[i * 4 + 2];
+    output[i * 4 + 1] = input[i * 4 + 1];
+    output[i * 4 + 2] = red;
+    output[i * 4 + 3] = input[i * 4 + 3];
+  }
+}
+
+void kdr::img::premultiplyAlpha(const uint8_t* input, uint8_t* output, const size_t pixelCount)
+{
+  size_t i = 0;
+#if defined(KDR_SIMD_SSE)
+  // Alpha is multiplied by 255, which divide255() turns back into alpha
+  const __m128i zero      = _mm_setzero_si128();
+  const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+  const __m128i alphaOne  = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+  const __m128i half      = _mm_set1_epi16(128);
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m128i pixels = _mm_loadu_si128((const __m128i*)(input + i * 4));
+    __m128i halves[2] {_mm_unpacklo_epi8(pixels, zero), _mm_unpackhi_epi8(pixels, zero)};
+    for (__m128i& channels : halves)
+    {
+      __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, 0xff), 0xff);
+      alpha = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaOne);
+      const __m128i value = _mm_add_epi16(_mm_mullo_epi16(channels, alpha), half);
+      channels = _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    }
+    _mm_storeu_si128((__m128i*)(output + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+  }
+#elif defined(KDR_SIMD_NEON)
+  for (; i + 16 <= pixelCount; i += 16)
+  {
+    uint8x16x4_t pixels = vld4q_u8(input + i * 4);
+    for (int c = 0; c < 3; c++)
+    {
+      const uint16x8_t low  = vmull_u8(vget_low_u8(pixels.val[c]), vget_low_u8(pixels.val[3]));
+      const uint16x8_t high = vmull_u8(vget_high_u8(pixels.val[c]), vget_high_u8(pixels.val[3]));
+      pixels.val[c] = vcombine_u8(
+        vrshrn_n_u16(vrsraq_n_u16(low, low, 8), 8),
+        vrshrn_n_u16(vrsraq_n_u16(high, high, 8), 8)
+      );
+    }
+    vst4q_u8(output + i * 4, pixels);
+  }
+#endif
+
+  for (; i < pixelCount; i++)
+  {
+    const unsigned int alpha = input[i * 4 + 3];
+    output[i * 4]     = divide255(input[i * 4] * alpha);
+    output[i * 4 + 1] = divide255(input[i * 4 + 1] * alpha);
+    output[i * 4 + 2] = divide255(input[i * 4 + 2] * alpha);
+    output[i * 4 + 3] = (uint8_t)alpha;
+  }
+}
+
+void kdr::img::decodePixels(const uint8_t* input, float* output, const size_t pixelCount, const bool isSRGB)
+{
+  const size_t size = pixelCount * 4;
+  if (isSRGB)
+  {
+    // Table lookups, which gathers would not speed up
+    const float* toLinear = getLinearTable();
+    for (size_t i = 0; i < size; i += 4)
+    {
+      output[i]     = toLinear[input[i]];
+      output[i + 1] = toLinear[input[i + 1]];
+      output[i + 2] = toLinear[input[i + 2]];
+      output[i + 3] = input[i + 3] / 255.f;
+    }
+    return;
+  }
+
+  size_t i = 0;
+#if defined(KDR_SIMD_SSE)
+  // Divided rather than multiplied by the reciprocal, to round like the scalar path
+  const __m128i zero  = _mm_setzero_si128();
+  const __m128  scale = _mm_set1_ps(255.f);
+  for (; i + 16 <= size; i += 16)
+  {
+    const __m128i bytes = _mm_loadu_si128((const __m128i*)(input + i));
+    const __m128i low   = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i high  = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_ps(output + i,      _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+    _mm_storeu_ps(output + i + 4,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+    _mm_storeu_ps(output + i + 8,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+    _mm_storeu_ps(output + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+  }
+#endif
+
+  for (; i < size; i++)
+  {
+    output[i] = input[i] / 255.f;
+  }
+}
+
+void kdr::img::encodePixels(const float* input, uint8_t* output, const size_t pixelCount, const bool isSRGB)
+{
+  const uint8_t* toSRGB = getSRGBTable();
+  // Color channels index the sRGB table when encoded, alpha is always quantized directly
+  const float colorScale = isSRGB ? (float)(SRGB_TABLE_SIZE - 1) : 255.f;
+
+  size_t i = 0;
+#if defined(KDR_SIMD_SSE)
+  const __m128 zero  = _mm_setzero_ps();
+  const __m128 one   = _mm_set1_ps(1.f);
+  const __m128 half  = _mm_set1_ps(0.5f);
+  const __m128 scale = _mm_setr_ps(colorScale, colorScale, colorScale, 255.f);
+  if (isSRGB)
+  {
+    alignas(16) int32_t indexes[4];
+    for (; i < pixelCount; i++)
+    {
+      const __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i * 4), zero), one);
+      _mm_store_si128((__m128i*)indexes, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half)));
+      output[i * 4]     = toSRGB[indexes[0]];
+      output[i * 4 + 1] = toSRGB[indexes[1]];
+      output[i * 4 + 2] = toSRGB[indexes[2]];
+      output[i * 4 + 3] = (uint8_t)indexes[3];
+    }
+  }
+  else
+  {
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+      __m128i quantized[4];
+      for (int p = 0; p < 4; p++)
+      {
+        const __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + (i + p) * 4), zero), one);
+        quantized[p] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+      }
+      const __m128i low  = _mm_packs_epi32(quantized[0], quantized[1]);
+      const __m128i high = _mm_packs_epi32(quantized[2], quantized[3]);
+      _mm_storeu_si128((__m128i*)(output + i * 4), _mm_packus_epi16(low, high));
+    }
+  }
+#endif
+
+  for (; i < pixelCount; i++)
+  {
+    for (int c = 0; c < 4; c++)
+    {
+      // NaN is clamped to 0 as well
+      const float value = input[i * 4 + c];
+      const float clamped = value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+      if (c < 3 && isSRGB)
+      {
+        output[i * 4 + c] = toSRGB[(int)(clamped * colorScale + 0.5f)];
+      }
+      else
+      {
+        output[i * 4 + c] = (uint8_t)(clamped * 255.f + 0.5f);
+      }
+    }
+  }
+}
+
+void kdr::img::flipRows(uint8_t* pixels, const size_t rowSize, const int height)
+{
+  if (rowSize == 0) return;
+
+  // memcpy() is already vectorized
+  std::vector<uint8_t> row(rowSize);
+  for (int y = 0; y < height / 2; y++)
+  {
+    uint8_t* top    = pixels + rowSize * y;
+    uint8_t* bottom = pixels + rowSize * (height - 1 - y);
+    memcpy(row.data(), top, rowSize);
+    memcpy(top, bottom, rowSize);
+    memcpy(bottom, row.data(), rowSize);
+  }
+}
@@ -0,0 +1,138 @@
+#include "Kedarium/ProgramCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// "KPB1", written before the binary format and length of every entry
+static constexpr uint32_t ENTRY_MAGIC {0x3142504b};
+
+static uint64_t hashBytes(uint64_t hash, const char* bytes, const size_t size)
+{
+  // 64-bit FNV-1a
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= (unsigned char)bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+static std::string getString(const GLenum name)
+{
+  const GLubyte* value = glGetString(name);
+  return value == NULL ? "" : (const char*)value;
+}
+
+kdr::gfx::ProgramCache::ProgramCache(const std::string& directory)
+: directory(directory)
+{
+  GLint formatCount {0};
+  if (GLEW_ARB_get_program_binary || GLEW_VERSION_4_1)
+  {
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+  }
+  this->supported = formatCount > 0;
+  if (!this->supported) return;
+
+  this->driver =
+    getString(GL_VENDOR) + '\n' +
+    getString(GL_RENDERER) + '\n' +
+    getString(GL_VERSION);
+
+  std::error_code error;
+  std::filesystem::create_directories(this->directory, error);
+  if (error)
+  {
+    std::cerr << "Failed to create the program cache directory (" << this->directory << ")!\n";
+    std::cerr << "Error: " << error.message() << '\n';
+  }
+}
+
+uint64_t kdr::gfx::ProgramCache::makeKey(const std::string& vertexSource, const std::string& fragmentSource) const
+{
+  // Separators keep ("ab", "c") and ("a", "bc") from hashing alike
+  uint64_t key = 0xcbf29ce484222325ull;
+  key = hashBytes(key, this->driver.data(), this->driver.size() + 1);
+  key = hashBytes(key, vertexSource.data(), vertexSource.size() + 1);
+  key = hashBytes(key, fragmentSource.data(), fragmentSource.size() + 1);
+  return key;
+}
+
+bool kdr::gfx::ProgramCache::load(const uint64_t key, const GLuint programID)
+{
+  if (!this->supported) return false;
+
+  // Opened at the end to get the size of the entry
+  std::ifstream file(this->_getEntryPath(key), std::ios::binary | std::ios::ate);
+  const std::streamoff fileSize = file.is_open() ? (std::streamoff)file.tellg() : -1;
+  uint32_t header[3] {0, 0, 0};
+  if (
+    fileSize < (std::streamoff)sizeof(header) ||
+    !file.seekg(0) ||
+    !file.read((char*)header, sizeof(header)) ||
+    header[0] != ENTRY_MAGIC ||
+    // An entry cut short, e.g. by the process exiting mid-store, is not allocated for
+    header[2] != (uint64_t)fileSize - sizeof(header)
+  )
+  {
+    this->stats.misses++;
+    return false;
+  }
+
+  std::vector<char> binary(header[2]);
+  if (!file.read(binary.data(), binary.size()))
+  {
+    this->stats.misses++;
+    return false;
+  }
+
+  glProgramBinary(programID, header[1], binary.data(), binary.size());
+  GLint success {0};
+  glGetProgramiv(programID, GL_LINK_STATUS, &success);
+  if (!success)
+  {
+    this->stats.rejections++;
+    return false;
+  }
+
+  this->stats.hits++;
+  return true;
+}
+
+void kdr::gfx::ProgramCache::store(const uint64_t key, const GLuint programID)
+{
+  if (!this->supported) return;
+
+  GLint length {0};
+  glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) return;
+
+  std::vector<char> binary(length);
+  GLenum format {0};
+  glGetProgramBinary(programID, length, &length, &format, binary.data());
+
+  const std::string path = this->_getEntryPath(key);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to write the program cache entry (" << path << ")!\n";
+    return;
+  }
+  const uint32_t header[3] {ENTRY_MAGIC, (uint32_t)format, (uint32_t)length};
+  file.write((const char*)header, sizeof(header));
+  file.write(binary.data(), length);
+  this->stats.stores++;
+}
+
+std::string kdr::gfx::ProgramCache::_getEntryPath(const uint64_t key) const
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string name(16, '0');
+  for (int i = 15; i >= 0; i--)
+  {
+    name[i] = digits[(key >> ((15 - i) * 4)) & 0xf];
+  }
+  return this->directory + '/' + name + ".bin";
+}
@@ -0,0 +1,123 @@
+#include "Kedarium/RenderQueue.hpp"
+
+static constexpr uint64_t ID_MASK    {0xfff};
+static constexpr uint64_t DEPTH_MASK {0xffffff};
+
+static uint64_t quantizeDepth(const float depth)
+{
+  const float clamped = depth < 0.f ? 0.f : (depth > 1.f ? 1.f : depth);
+  return (uint64_t)(clamped * (float)DEPTH_MASK) & DEPTH_MASK;
+}
+
+uint64_t kdr::gfx::RenderQueue::makeKey(const kdr::gfx::RenderPass pass, const kdr::gfx::DrawCommand& command, const float depth)
+{
+  const uint64_t shader  = command.shaderID  & ID_MASK;
+  const uint64_t texture = command.textureID & ID_MASK;
+  const uint64_t vao     = command.vaoID     & ID_MASK;
+
+  uint64_t key = (uint64_t)pass << 60;
+  if (pass == kdr::gfx::RenderPass::Transparent)
+  {
+    key |= (DEPTH_MASK - quantizeDepth(depth)) << 36;
+    key |= shader  << 24;
+    key |= texture << 12;
+    key |= vao;
+  }
+  else
+  {
+    key |= shader  << 48;
+    key |= texture << 36;
+    key |= vao     << 24;
+    key |= quantizeDepth(depth);
+  }
+  return key;
+}
+
+void kdr::gfx::RenderQueue::Submit(const kdr::gfx::RenderPass pass, const kdr::gfx::DrawCommand& command, const float depth)
+{
+  this->keys.push_back(makeKey(pass, command, depth));
+  this->commands.push_back(command);
+}
+
+void kdr::gfx::RenderQueue::Sort()
+{
+  const size_t count = this->keys.size();
+  this->order.resize(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    this->order[i] = i;
+  }
+  if (count < 2) return;
+
+  // One histogram per byte, all filled in a single pass over the keys
+  size_t histograms[8][256] {};
+  for (const uint64_t key : this->keys)
+  {
+    for (int byte = 0; byte < 8; byte++)
+    {
+      histograms[byte][(key >> (byte * 8)) & 0xff]++;
+    }
+  }
+
+  this->sortedKeys.assign(this->keys.begin(), this->keys.end());
+  this->scratchKeys.resize(count);
+  this->scratchOrder.resize(count);
+  for (int byte = 0; byte < 8; byte++)
+  {
+    size_t* histogram = histograms[byte];
+    const int shift = byte * 8;
+
+    // Every key has the same byte here, so the pass would not move anything
+    if (histogram[(this->sortedKeys[0] >> shift) & 0xff] == count) continue;
+
+    size_t offset = 0;
+    for (int bucket = 0; bucket < 256; bucket++)
+    {
+      const size_t bucketSize = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucketSize;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      const size_t destination = histogram[(this->sortedKeys[i] >> shift) & 0xff]++;
+      this->scratchKeys[destination]  = this->sortedKeys[i];
+      this->scratchOrder[destination] = this->order[i];
+    }
+    this->sortedKeys.swap(this->scratchKeys);
+    this->order.swap(this->scratchOrder);
+  }
+}
+
+void kdr::gfx::RenderQueue::Execute()
+{
+  this->Sort();
+
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.activeTexture(GL_TEXTURE0);
+  for (const uint32_t index : this->order)
+  {
+    const kdr::gfx::DrawCommand& command = this->commands[index];
+    state.useProgram(command.shaderID);
+    state.bindVertexArray(command.vaoID);
+    if (command.textureID != 0)
+    {
+      state.bindTexture(command.textureType, command.textureID);
+    }
+
+    if (command.instanceCount == 1)
+    {
+      glDrawElements(command.mode, command.count, command.indexType, command.offset);
+    }
+    else
+    {
+      glDrawElementsInstanced(command.mode, command.count, command.indexType, command.offset, command.instanceCount);
+    }
+  }
+}
+
+void kdr::gfx::RenderQueue::Clear()
+{
+  this->commands.clear();
+  this->keys.clear();
+  this->order.clear();
+}
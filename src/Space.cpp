@@ -1,24 +1,421 @@
 #include "Kedarium/Space.hpp"
+#include "Kedarium/Simd.hpp"
 
-kdr::space::Mat4 kdr::space::translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec)
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static void transformRange(
+  const kdr::space::Mat4& mat,
+  const float w,
+  const float* xs,
+  const float* ys,
+  const float* zs,
+  float* outXs,
+  float* outYs,
+  float* outZs,
+  size_t begin,
+  const size_t end
+)
 {
-  kdr::space::Mat4 result {mat};
-  result[3][0] += vec.x;
-  result[3][1] += vec.y;
-  result[3][2] += vec.z;
-  return result;
+  // Points pick up the translation column, directions add an exact zero.
+  const float tx = mat[3][0] * w;
+  const float ty = mat[3][1] * w;
+  const float tz = mat[3][2] * w;
+
+#if defined(KDR_SIMD_AVX)
+  const __m256 m00 = _mm256_set1_ps(mat[0][0]), m01 = _mm256_set1_ps(mat[0][1]), m02 = _mm256_set1_ps(mat[0][2]);
+  const __m256 m10 = _mm256_set1_ps(mat[1][0]), m11 = _mm256_set1_ps(mat[1][1]), m12 = _mm256_set1_ps(mat[1][2]);
+  const __m256 m20 = _mm256_set1_ps(mat[2][0]), m21 = _mm256_set1_ps(mat[2][1]), m22 = _mm256_set1_ps(mat[2][2]);
+  const __m256 vtx = _mm256_set1_ps(tx), vty = _mm256_set1_ps(ty), vtz = _mm256_set1_ps(tz);
+
+  for (; begin + 8 <= end; begin += 8)
+  {
+    const __m256 x = _mm256_loadu_ps(xs + begin);
+    const __m256 y = _mm256_loadu_ps(ys + begin);
+    const __m256 z = _mm256_loadu_ps(zs + begin);
+    __m256 rx = _mm256_mul_ps(m00, x);
+    __m256 ry = _mm256_mul_ps(m01, x);
+    __m256 rz = _mm256_mul_ps(m02, x);
+    rx = _mm256_add_ps(rx, _mm256_mul_ps(m10, y));
+    ry = _mm256_add_ps(ry, _mm256_mul_ps(m11, y));
+    rz = _mm256_add_ps(rz, _mm256_mul_ps(m12, y));
+    rx = _mm256_add_ps(rx, _mm256_mul_ps(m20, z));
+    ry = _mm256_add_ps(ry, _mm256_mul_ps(m21, z));
+    rz = _mm256_add_ps(rz, _mm256_mul_ps(m22, z));
+    _mm256_storeu_ps(outXs + begin, _mm256_add_ps(rx, vtx));
+    _mm256_storeu_ps(outYs + begin, _mm256_add_ps(ry, vty));
+    _mm256_storeu_ps(outZs + begin, _mm256_add_ps(rz, vtz));
+  }
+#elif defined(KDR_SIMD_SSE)
+  const __m128 m00 = _mm_set1_ps(mat[0][0]), m01 = _mm_set1_ps(mat[0][1]), m02 = _mm_set1_ps(mat[0][2]);
+  const __m128 m10 = _mm_set1_ps(mat[1][0]), m11 = _mm_set1_ps(mat[1][1]), m12 = _mm_set1_ps(mat[1][2]);
+  const __m128 m20 = _mm_set1_ps(mat[2][0]), m21 = _mm_set1_ps(mat[2][1]), m22 = _mm_set1_ps(mat[2][2]);
+  const __m128 vtx = _mm_set1_ps(tx), vty = _mm_set1_ps(ty), vtz = _mm_set1_ps(tz);
+
+  for (; begin + 4 <= end; begin += 4)
+  {
+    const __m128 x = _mm_loadu_ps(xs + begin);
+    const __m128 y = _mm_loadu_ps(ys + begin);
+    const __m128 z = _mm_loadu_ps(zs + begin);
+    __m128 rx = _mm_mul_ps(m00, x);
+    __m128 ry = _mm_mul_ps(m01, x);
+    __m128 rz = _mm_mul_ps(m02, x);
+    rx = _mm_add_ps(rx, _mm_mul_ps(m10, y));
+    ry = _mm_add_ps(ry, _mm_mul_ps(m11, y));
+    rz = _mm_add_ps(rz, _mm_mul_ps(m12, y));
+    rx = _mm_add_ps(rx, _mm_mul_ps(m20, z));
+    ry = _mm_add_ps(ry, _mm_mul_ps(m21, z));
+    rz = _mm_add_ps(rz, _mm_mul_ps(m22, z));
+    _mm_storeu_ps(outXs + begin, _mm_add_ps(rx, vtx));
+    _mm_storeu_ps(outYs + begin, _mm_add_ps(ry, vty));
+    _mm_storeu_ps(outZs + begin, _mm_add_ps(rz, vtz));
+  }
+#elif defined(KDR_SIMD_NEON)
+  const float32x4_t vtx = vdupq_n_f32(tx), vty = vdupq_n_f32(ty), vtz = vdupq_n_f32(tz);
+
+  for (; begin + 4 <= end; begin += 4)
+  {
+    const float32x4_t x = vld1q_f32(xs + begin);
+    const float32x4_t y = vld1q_f32(ys + begin);
+    const float32x4_t z = vld1q_f32(zs + begin);
+    float32x4_t rx = vmulq_n_f32(x, mat[0][0]);
+    float32x4_t ry = vmulq_n_f32(x, mat[0][1]);
+    float32x4_t rz = vmulq_n_f32(x, mat[0][2]);
+    rx = vaddq_f32(rx, vmulq_n_f32(y, mat[1][0]));
+    ry = vaddq_f32(ry, vmulq_n_f32(y, mat[1][1]));
+    rz = vaddq_f32(rz, vmulq_n_f32(y, mat[1][2]));
+    rx = vaddq_f32(rx, vmulq_n_f32(z, mat[2][0]));
+    ry = vaddq_f32(ry, vmulq_n_f32(z, mat[2][1]));
+    rz = vaddq_f32(rz, vmulq_n_f32(z, mat[2][2]));
+    vst1q_f32(outXs + begin, vaddq_f32(rx, vtx));
+    vst1q_f32(outYs + begin, vaddq_f32(ry, vty));
+    vst1q_f32(outZs + begin, vaddq_f32(rz, vtz));
+  }
+#endif
+
+  for (; begin < end; begin++)
+  {
+    const float x = xs[begin];
+    const float y = ys[begin];
+    const float z = zs[begin];
+    outXs[begin] = mat[0][0] * x + mat[1][0] * y + mat[2][0] * z + tx;
+    outYs[begin] = mat[0][1] * x + mat[1][1] * y + mat[2][1] * z + ty;
+    outZs[begin] = mat[0][2] * x + mat[1][2] * y + mat[2][2] * z + tz;
+  }
 }
 
-kdr::space::Mat4 kdr::space::perspective(const float fov, const float aspect, const float near, const float far)
+/**
+ * A batched transform split into chunks that the calling thread and the
+ * pool workers claim one at a time.
+ */
+struct TransformJob
+{
+  const kdr::space::Mat4* mat;
+  float                   w;
+  const float*            xs;
+  const float*            ys;
+  const float*            zs;
+  float*                  outXs;
+  float*                  outYs;
+  float*                  outZs;
+  size_t                  count;
+  size_t                  chunkSize;
+  size_t                  chunkCount;
+  std::atomic<size_t>     nextChunk;
+};
+
+/**
+ * Worker threads for the batched transforms, started on first use and
+ * joined at exit, so a batch does not pay for creating threads every frame.
+ */
+class TransformPool
 {
+  public:
+    TransformPool()
+    {
+      const unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+      // The calling thread works on the batch as well
+      for (unsigned int i = 1; i < threadCount; i++)
+      {
+        this->workers.emplace_back(&TransformPool::_work, this);
+      }
+    }
+    ~TransformPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+      }
+      this->jobCondition.notify_all();
+      for (std::thread& worker : this->workers)
+      {
+        worker.join();
+      }
+    }
+
+    TransformPool(const TransformPool&) = delete;
+    TransformPool& operator=(const TransformPool&) = delete;
+
+    /**
+     * Gets the number of threads a batch can be split across, the calling thread included.
+     *
+     * @return The number of threads.
+     */
+    size_t getThreadCount() const
+    { return this->workers.size() + 1; }
+
+    /**
+     * Runs a job on the calling thread and the workers, returning once every chunk is done.
+     * If another thread is already running a job, the calling thread runs this one alone.
+     *
+     * @param job The job.
+     */
+    void Run(TransformJob& job)
+    {
+      std::unique_lock<std::mutex> runLock(this->runMutex, std::try_to_lock);
+      if (!runLock.owns_lock())
+      {
+        _runChunks(job);
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->job = &job;
+        this->generation++;
+      }
+      this->jobCondition.notify_all();
+      _runChunks(job);
+
+      // Workers that have not picked up the job yet find no chunks left
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->doneCondition.wait(lock, [this]() { return this->activeWorkers == 0; });
+      this->job = NULL;
+    }
+
+  private:
+    std::vector<std::thread> workers;
+    std::mutex               runMutex;
+    std::mutex               mutex;
+    std::condition_variable  jobCondition;
+    std::condition_variable  doneCondition;
+    TransformJob*            job           {NULL};
+    uint64_t                 generation    {0};
+    size_t                   activeWorkers {0};
+    bool                     stopping      {false};
+
+    void _work()
+    {
+      uint64_t seenGeneration {0};
+      std::unique_lock<std::mutex> lock(this->mutex);
+      while (true)
+      {
+        this->jobCondition.wait(lock, [&]() { return this->stopping || this->generation != seenGeneration; });
+        if (this->stopping) return;
+        seenGeneration = this->generation;
+        TransformJob* job = this->job;
+        if (job == NULL) continue;
+
+        this->activeWorkers++;
+        lock.unlock();
+        _runChunks(*job);
+        lock.lock();
+        if (--this->activeWorkers == 0)
+        {
+          this->doneCondition.notify_all();
+        }
+      }
+    }
+
+    static void _runChunks(TransformJob& job)
+    {
+      for (size_t chunk = job.nextChunk.fetch_add(1); chunk < job.chunkCount; chunk = job.nextChunk.fetch_add(1))
+      {
+        const size_t begin = chunk * job.chunkSize;
+        const size_t end   = std::min(begin + job.chunkSize, job.count);
+        transformRange(*job.mat, job.w, job.xs, job.ys, job.zs, job.outXs, job.outYs, job.outZs, begin, end);
+      }
+    }
+};
+
+static void transformBatch(
+  const kdr::space::Mat4& mat,
+  const float w,
+  const float* xs,
+  const float* ys,
+  const float* zs,
+  float* outXs,
+  float* outYs,
+  float* outZs,
+  const size_t count
+)
+{
+  // One thread per started BATCH_PARALLEL_THRESHOLD elements
+  const size_t chunkCount = (count + kdr::space::BATCH_PARALLEL_THRESHOLD - 1) / kdr::space::BATCH_PARALLEL_THRESHOLD;
+  if (chunkCount <= 1)
+  {
+    transformRange(mat, w, xs, ys, zs, outXs, outYs, outZs, 0, count);
+    return;
+  }
+
+  static TransformPool pool;
+  const size_t threadCount = std::min(pool.getThreadCount(), chunkCount);
+  if (threadCount <= 1)
+  {
+    transformRange(mat, w, xs, ys, zs, outXs, outYs, outZs, 0, count);
+    return;
+  }
+
+  // Chunks are rounded to a multiple of 8 so that only the last one has a scalar tail.
+  TransformJob job;
+  job.mat        = &mat;
+  job.w          = w;
+  job.xs         = xs;
+  job.ys         = ys;
+  job.zs         = zs;
+  job.outXs      = outXs;
+  job.outYs      = outYs;
+  job.outZs      = outZs;
+  job.count      = count;
+  job.chunkSize  = ((count + threadCount - 1) / threadCount + 7) & ~(size_t)7;
+  job.chunkCount = (count + job.chunkSize - 1) / job.chunkSize;
+  job.nextChunk  = 0;
+  pool.Run(job);
+}
+
+kdr::space::Mat4 kdr::space::simd::multiply(const kdr::space::Mat4& matA, const kdr::space::Mat4& matB)
+{
+#if defined(KDR_SIMD_AVX)
+  kdr::space::Mat4 result;
+  const __m256 colA0 = _mm256_broadcast_ps((const __m128*)matA[0]);
+  const __m256 colA1 = _mm256_broadcast_ps((const __m128*)matA[1]);
+  const __m256 colA2 = _mm256_broadcast_ps((const __m128*)matA[2]);
+  const __m256 colA3 = _mm256_broadcast_ps((const __m128*)matA[3]);
+
+  // Two result columns per iteration; each 128-bit lane holds one column of matB.
+  for (int i = 0; i < 4; i += 2)
+  {
+    const __m256 colsB = _mm256_insertf128_ps(
+      _mm256_castps128_ps256(_mm_load_ps(matB[i])),
+      _mm_load_ps(matB[i + 1]),
+      1
+    );
+    __m256 sum = _mm256_mul_ps(colA0, _mm256_shuffle_ps(colsB, colsB, 0x00));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(colA1, _mm256_shuffle_ps(colsB, colsB, 0x55)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(colA2, _mm256_shuffle_ps(colsB, colsB, 0xAA)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(colA3, _mm256_shuffle_ps(colsB, colsB, 0xFF)));
+    _mm_store_ps(result[i], _mm256_castps256_ps128(sum));
+    _mm_store_ps(result[i + 1], _mm256_extractf128_ps(sum, 1));
+  }
+  return result;
+#elif defined(KDR_SIMD_SSE)
+  kdr::space::Mat4 result;
+  const __m128 colA0 = _mm_load_ps(matA[0]);
+  const __m128 colA1 = _mm_load_ps(matA[1]);
+  const __m128 colA2 = _mm_load_ps(matA[2]);
+  const __m128 colA3 = _mm_load_ps(matA[3]);
+
+  for (int i = 0; i < 4; i++)
+  {
+    const __m128 colB = _mm_load_ps(matB[i]);
+    __m128 sum = _mm_mul_ps(colA0, _mm_shuffle_ps(colB, colB, 0x00));
+    sum = _mm_add_ps(sum, _mm_mul_ps(colA1, _mm_shuffle_ps(colB, colB, 0x55)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(colA2, _mm_shuffle_ps(colB, colB, 0xAA)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(colA3, _mm_shuffle_ps(colB, colB, 0xFF)));
+    _mm_store_ps(result[i], sum);
+  }
+  return result;
+#elif defined(KDR_SIMD_NEON)
   kdr::space::Mat4 result;
-  const float halfTanFOV = tanf(kdr::space::radians(fov)) / 2.f;
+  const float32x4_t colA0 = vld1q_f32(matA[0]);
+  const float32x4_t colA1 = vld1q_f32(matA[1]);
+  const float32x4_t colA2 = vld1q_f32(matA[2]);
+  const float32x4_t colA3 = vld1q_f32(matA[3]);
+
+  for (int i = 0; i < 4; i++)
+  {
+    float32x4_t sum = vmulq_n_f32(colA0, matB[i][0]);
+    sum = vaddq_f32(sum, vmulq_n_f32(colA1, matB[i][1]));
+    sum = vaddq_f32(sum, vmulq_n_f32(colA2, matB[i][2]));
+    sum = vaddq_f32(sum, vmulq_n_f32(colA3, matB[i][3]));
+    vst1q_f32(result[i], sum);
+  }
+  return result;
+#else
+  return kdr::space::scalar::multiply(matA, matB);
+#endif
+}
 
-  result[0][0] = 1.f / (halfTanFOV * aspect);
-  result[1][1] = 1.f / halfTanFOV;
-  result[2][2] = (far + near) / (near - far);
-  result[2][3] = -1.f;
-  result[3][2] = -(2.f * far * near) / (far - near);
+kdr::space::Vec4 kdr::space::simd::transform(const kdr::space::Mat4& mat, const kdr::space::Vec4& vec)
+{
+#if defined(KDR_SIMD_SSE)
+  kdr::space::Vec4 result {0.f};
+  const __m128 v = _mm_load_ps(&vec.x);
+  __m128 sum = _mm_mul_ps(_mm_load_ps(mat[0]), _mm_shuffle_ps(v, v, 0x00));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(mat[1]), _mm_shuffle_ps(v, v, 0x55)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(mat[2]), _mm_shuffle_ps(v, v, 0xAA)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(mat[3]), _mm_shuffle_ps(v, v, 0xFF)));
+  _mm_store_ps(&result.x, sum);
+  return result;
+#elif defined(KDR_SIMD_NEON)
+  kdr::space::Vec4 result {0.f};
+  float32x4_t sum = vmulq_n_f32(vld1q_f32(mat[0]), vec.x);
+  sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(mat[1]), vec.y));
+  sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(mat[2]), vec.z));
+  sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(mat[3]), vec.w));
+  vst1q_f32(&result.x, sum);
+  return result;
+#else
+  return kdr::space::scalar::transform(mat, vec);
+#endif
+}
 
+kdr::space::Mat4 kdr::space::simd::translate(const kdr::space::Mat4& mat, const kdr::space::Vec3& vec)
+{
+#if defined(KDR_SIMD_SSE)
+  kdr::space::Mat4 result {mat};
+  // Adding -0 leaves the w element bit-for-bit unchanged, including signed zeros.
+  const __m128 offset = _mm_setr_ps(vec.x, vec.y, vec.z, -0.f);
+  _mm_store_ps(result[3], _mm_add_ps(_mm_load_ps(mat[3]), offset));
+  return result;
+#elif defined(KDR_SIMD_NEON)
+  kdr::space::Mat4 result {mat};
+  const float offsetData[4] {vec.x, vec.y, vec.z, -0.f};
+  vst1q_f32(result[3], vaddq_f32(vld1q_f32(mat[3]), vld1q_f32(offsetData)));
   return result;
+#else
+  return kdr::space::scalar::translate(mat, vec);
+#endif
+}
+
+void kdr::space::transformPoints(
+  const kdr::space::Mat4& mat,
+  const float* xs,
+  const float* ys,
+  const float* zs,
+  float* outXs,
+  float* outYs,
+  float* outZs,
+  const size_t count
+)
+{
+  transformBatch(mat, 1.f, xs, ys, zs, outXs, outYs, outZs, count);
+}
+
+void kdr::space::transformDirections(
+  const kdr::space::Mat4& mat,
+  const float* xs,
+  const float* ys,
+  const float* zs,
+  float* outXs,
+  float* outYs,
+  float* outZs,
+  const size_t count
+)
+{
+  transformBatch(mat, 0.f, xs, ys, zs, outXs, outYs, outZs, count);
 }
@@ -0,0 +1,411 @@
+#include "Kedarium/Spatial.hpp"
+
+static inline float minOf(const float a, const float b)
+{ return a < b ? a : b; }
+
+static inline float maxOf(const float a, const float b)
+{ return a > b ? a : b; }
+
+static inline kdr::space::AABB unionOf(const kdr::space::AABB& boxA, const kdr::space::AABB& boxB)
+{
+  return kdr::space::AABB {
+    {minOf(boxA.min.x, boxB.min.x), minOf(boxA.min.y, boxB.min.y), minOf(boxA.min.z, boxB.min.z)},
+    {maxOf(boxA.max.x, boxB.max.x), maxOf(boxA.max.y, boxB.max.y), maxOf(boxA.max.z, boxB.max.z)}
+  };
+}
+
+static inline bool isSameBox(const kdr::space::AABB& boxA, const kdr::space::AABB& boxB)
+{
+  return boxA.min == boxB.min && boxA.max == boxB.max;
+}
+
+static inline float halfArea(const kdr::space::AABB& box)
+{
+  const kdr::space::Vec3 size = box.max - box.min;
+  return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+static bool contains(const kdr::space::AABB& outer, const kdr::space::AABB& inner)
+{
+  return
+    outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+    outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static bool overlaps(const kdr::space::AABB& boxA, const kdr::space::AABB& boxB)
+{
+  return
+    boxA.min.x <= boxB.max.x && boxA.min.y <= boxB.max.y && boxA.min.z <= boxB.max.z &&
+    boxA.max.x >= boxB.min.x && boxA.max.y >= boxB.min.y && boxA.max.z >= boxB.min.z;
+}
+
+/**
+ * Classifies a box against a frustum: -1 if outside, 1 if fully inside, 0 if intersecting.
+ */
+static int classify(const kdr::space::Frustum& frustum, const kdr::space::AABB& box)
+{
+  const kdr::space::Vec3 center = (box.min + box.max) * 0.5f;
+  const kdr::space::Vec3 extent = (box.max - box.min) * 0.5f;
+  int result = 1;
+  for (const kdr::space::Plane& plane : frustum.planes)
+  {
+    const float dist   = kdr::space::dot(plane.normal, center) + plane.distance;
+    const float radius = fabsf(plane.normal.x) * extent.x + fabsf(plane.normal.y) * extent.y + fabsf(plane.normal.z) * extent.z;
+    if (dist + radius < 0.f) return -1;
+    if (dist - radius < 0.f) result = 0;
+  }
+  return result;
+}
+
+static bool intersectsRay(const kdr::space::AABB& box, const kdr::space::Vec3& origin, const kdr::space::Vec3& invDirection, const float maxDistance)
+{
+  const float tx1 = (box.min.x - origin.x) * invDirection.x;
+  const float tx2 = (box.max.x - origin.x) * invDirection.x;
+  const float ty1 = (box.min.y - origin.y) * invDirection.y;
+  const float ty2 = (box.max.y - origin.y) * invDirection.y;
+  const float tz1 = (box.min.z - origin.z) * invDirection.z;
+  const float tz2 = (box.max.z - origin.z) * invDirection.z;
+
+  // fminf/fmaxf drop the NaNs produced by axis-parallel rays starting on a slab boundary.
+  const float tMin = fmaxf(fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), fminf(tz1, tz2)), 0.f);
+  const float tMax = fminf(fminf(fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2)), fmaxf(tz1, tz2)), maxDistance);
+  return tMin <= tMax;
+}
+
+int kdr::space::DynamicBVH::insert(const kdr::space::AABB& box, const uint32_t userData)
+{
+  const int leaf = this->_allocateNode();
+  Node& node = this->nodes[leaf];
+  node.box      = {box.min - this->margin, box.max + this->margin};
+  node.userData = userData;
+  node.height   = 0;
+
+  this->_insertLeaf(leaf);
+  this->proxyCount++;
+  return leaf;
+}
+
+void kdr::space::DynamicBVH::remove(const int proxyID)
+{
+  this->_removeLeaf(proxyID);
+  this->_freeNode(proxyID);
+  this->proxyCount--;
+}
+
+bool kdr::space::DynamicBVH::move(const int proxyID, const kdr::space::AABB& box, const kdr::space::Vec3& displacement)
+{
+  kdr::space::AABB fatBox {box.min - this->margin, box.max + this->margin};
+  (displacement.x < 0.f ? fatBox.min.x : fatBox.max.x) += displacement.x;
+  (displacement.y < 0.f ? fatBox.min.y : fatBox.max.y) += displacement.y;
+  (displacement.z < 0.f ? fatBox.min.z : fatBox.max.z) += displacement.z;
+
+  const kdr::space::AABB& treeBox = this->nodes[proxyID].box;
+  if (contains(treeBox, box))
+  {
+    // Keep the leaf unless its box has grown far larger than it needs to be.
+    const float slack = 4.f * this->margin;
+    const kdr::space::AABB hugeBox {fatBox.min - slack, fatBox.max + slack};
+    if (contains(hugeBox, treeBox)) return false;
+  }
+
+  this->_removeLeaf(proxyID);
+  this->nodes[proxyID].box = fatBox;
+  this->_insertLeaf(proxyID);
+  return true;
+}
+
+void kdr::space::DynamicBVH::queryAABB(const kdr::space::AABB& box, std::vector<uint32_t>& results) const
+{
+  results.clear();
+  if (this->root == NULL_NODE) return;
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(this->root);
+  while (!stack.empty())
+  {
+    const Node& node = this->nodes[stack.back()];
+    stack.pop_back();
+    if (!overlaps(node.box, box)) continue;
+
+    if (node.isLeaf())
+    {
+      results.push_back(node.userData);
+    }
+    else
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+void kdr::space::DynamicBVH::queryFrustum(const kdr::space::Frustum& frustum, std::vector<uint32_t>& results) const
+{
+  results.clear();
+  if (this->root == NULL_NODE) return;
+
+  // Entries are index * 2 + 1 for subtrees already known to be fully inside.
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(this->root * 2);
+  while (!stack.empty())
+  {
+    const int entry  = stack.back();
+    const Node& node = this->nodes[entry / 2];
+    stack.pop_back();
+
+    int inside = entry & 1;
+    if (!inside)
+    {
+      const int side = classify(frustum, node.box);
+      if (side < 0) continue;
+      inside = side;
+    }
+
+    if (node.isLeaf())
+    {
+      results.push_back(node.userData);
+    }
+    else
+    {
+      stack.push_back(node.child1 * 2 + inside);
+      stack.push_back(node.child2 * 2 + inside);
+    }
+  }
+}
+
+void kdr::space::DynamicBVH::queryRay(const kdr::space::Ray& ray, const float maxDistance, std::vector<uint32_t>& results) const
+{
+  results.clear();
+  if (this->root == NULL_NODE) return;
+
+  const kdr::space::Vec3 invDirection {
+    1.f / ray.direction.x,
+    1.f / ray.direction.y,
+    1.f / ray.direction.z
+  };
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(this->root);
+  while (!stack.empty())
+  {
+    const Node& node = this->nodes[stack.back()];
+    stack.pop_back();
+    if (!intersectsRay(node.box, ray.origin, invDirection, maxDistance)) continue;
+
+    if (node.isLeaf())
+    {
+      results.push_back(node.userData);
+    }
+    else
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+int kdr::space::DynamicBVH::_allocateNode()
+{
+  if (this->freeList == NULL_NODE)
+  {
+    this->nodes.emplace_back();
+    return (int)this->nodes.size() - 1;
+  }
+
+  const int index = this->freeList;
+  this->freeList = this->nodes[index].parent;
+  this->nodes[index] = Node {};
+  return index;
+}
+
+void kdr::space::DynamicBVH::_freeNode(const int index)
+{
+  this->nodes[index].parent = this->freeList;
+  this->nodes[index].height = -1;
+  this->freeList = index;
+}
+
+void kdr::space::DynamicBVH::_insertLeaf(const int leaf)
+{
+  if (this->root == NULL_NODE)
+  {
+    this->root = leaf;
+    this->nodes[leaf].parent = NULL_NODE;
+    return;
+  }
+
+  // Descend towards the sibling with the lowest surface area cost.
+  const kdr::space::AABB leafBox = this->nodes[leaf].box;
+  int index = this->root;
+  while (!this->nodes[index].isLeaf())
+  {
+    const Node& node = this->nodes[index];
+    const float combinedArea = halfArea(unionOf(node.box, leafBox));
+    const float cost         = 2.f * combinedArea;
+    const float inheritance  = 2.f * (combinedArea - halfArea(node.box));
+
+    float childCosts[2];
+    const int children[2] {node.child1, node.child2};
+    for (int i = 0; i < 2; i++)
+    {
+      const Node& child = this->nodes[children[i]];
+      const float newArea = halfArea(unionOf(child.box, leafBox));
+      childCosts[i] = (child.isLeaf() ? newArea : newArea - halfArea(child.box)) + inheritance;
+    }
+
+    if (cost < childCosts[0] && cost < childCosts[1]) break;
+    index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+  }
+
+  const int sibling   = index;
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->_allocateNode();
+
+  Node& parentNode  = this->nodes[newParent];
+  parentNode.parent = oldParent;
+  parentNode.child1 = sibling;
+  parentNode.child2 = leaf;
+  parentNode.box    = unionOf(this->nodes[sibling].box, leafBox);
+  parentNode.height = this->nodes[sibling].height + 1;
+
+  if (oldParent != NULL_NODE)
+  {
+    Node& grandParent = this->nodes[oldParent];
+    (grandParent.child1 == sibling ? grandParent.child1 : grandParent.child2) = newParent;
+  }
+  else
+  {
+    this->root = newParent;
+  }
+  this->nodes[sibling].parent = newParent;
+  this->nodes[leaf].parent    = newParent;
+
+  this->_refit(newParent);
+}
+
+void kdr::space::DynamicBVH::_removeLeaf(const int leaf)
+{
+  if (leaf == this->root)
+  {
+    this->root = NULL_NODE;
+    return;
+  }
+
+  const int parent      = this->nodes[leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling     = this->nodes[parent].child1 == leaf
+    ? this->nodes[parent].child2
+    : this->nodes[parent].child1;
+
+  this->nodes[sibling].parent = grandParent;
+  this->_freeNode(parent);
+
+  if (grandParent != NULL_NODE)
+  {
+    Node& grandParentNode = this->nodes[grandParent];
+    (grandParentNode.child1 == parent ? grandParentNode.child1 : grandParentNode.child2) = sibling;
+    this->_refit(grandParent);
+  }
+  else
+  {
+    this->root = sibling;
+  }
+}
+
+void kdr::space::DynamicBVH::_refit(int index)
+{
+  // The first node was just relinked, so its parent always needs a refit. Past
+  // it, ancestors only depend on each node's box and height.
+  bool isFirst = true;
+  while (index != NULL_NODE)
+  {
+    const kdr::space::AABB oldBox    = this->nodes[index].box;
+    const int              oldHeight = this->nodes[index].height;
+    this->_updateNode(index);
+    const bool rotated = this->_rotate(index);
+
+    const Node& node = this->nodes[index];
+    if (!isFirst && !rotated && node.height == oldHeight && isSameBox(node.box, oldBox)) break;
+    isFirst = false;
+    index   = node.parent;
+  }
+}
+
+bool kdr::space::DynamicBVH::_rotate(const int index)
+{
+  Node& nodeA = this->nodes[index];
+  if (nodeA.height < 2) return false;
+
+  const int b = nodeA.child1;
+  const int c = nodeA.child2;
+  Node& nodeB = this->nodes[b];
+  Node& nodeC = this->nodes[c];
+
+  // Candidate swaps between a child of A and a grandchild on the other side,
+  // scored by the change in surface area of the node that gains the child.
+  enum Swap { None, CWithD, CWithE, BWithF, BWithG };
+  Swap  bestSwap {None};
+  float bestCost {0.f};
+
+  if (!nodeB.isLeaf())
+  {
+    const float areaB = halfArea(nodeB.box);
+    const float costD = halfArea(unionOf(nodeC.box, this->nodes[nodeB.child2].box)) - areaB;
+    const float costE = halfArea(unionOf(nodeC.box, this->nodes[nodeB.child1].box)) - areaB;
+    if (costD < bestCost) { bestSwap = CWithD; bestCost = costD; }
+    if (costE < bestCost) { bestSwap = CWithE; bestCost = costE; }
+  }
+  if (!nodeC.isLeaf())
+  {
+    const float areaC = halfArea(nodeC.box);
+    const float costF = halfArea(unionOf(nodeB.box, this->nodes[nodeC.child2].box)) - areaC;
+    const float costG = halfArea(unionOf(nodeB.box, this->nodes[nodeC.child1].box)) - areaC;
+    if (costF < bestCost) { bestSwap = BWithF; bestCost = costF; }
+    if (costG < bestCost) { bestSwap = BWithG; bestCost = costG; }
+  }
+
+  switch (bestSwap)
+  {
+    case CWithD:
+      nodeA.child2 = nodeB.child1;
+      nodeB.child1 = c;
+      break;
+    case CWithE:
+      nodeA.child2 = nodeB.child2;
+      nodeB.child2 = c;
+      break;
+    case BWithF:
+      nodeA.child1 = nodeC.child1;
+      nodeC.child1 = b;
+      break;
+    case BWithG:
+      nodeA.child1 = nodeC.child2;
+      nodeC.child2 = b;
+      break;
+    case None:
+      return false;
+  }
+
+  const bool bGainedChild = bestSwap == CWithD || bestSwap == CWithE;
+  const int  promoted     = bGainedChild ? nodeA.child2 : nodeA.child1;
+  const int  demoted      = bGainedChild ? c : b;
+  const int  gainer       = bGainedChild ? b : c;
+
+  this->nodes[promoted].parent = index;
+  this->nodes[demoted].parent  = gainer;
+  this->_updateNode(gainer);
+  this->_updateNode(index);
+  return true;
+}
+
+void kdr::space::DynamicBVH::_updateNode(const int index)
+{
+  Node& node = this->nodes[index];
+  const Node& child1 = this->nodes[node.child1];
+  const Node& child2 = this->nodes[node.child2];
+  node.box    = unionOf(child1.box, child2.box);
+  node.height = 1 + (child1.height > child2.height ? child1.height : child2.height);
+}
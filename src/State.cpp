@@ -0,0 +1,181 @@
+#include "Kedarium/State.hpp"
+
+static int getBufferSlot(const GLenum target)
+{
+  switch (target)
+  {
+    case GL_ARRAY_BUFFER:         return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return 1;
+    case GL_UNIFORM_BUFFER:       return 2;
+    case GL_PIXEL_UNPACK_BUFFER:  return 3;
+    case GL_PIXEL_PACK_BUFFER:    return 4;
+    case GL_DRAW_INDIRECT_BUFFER: return 5;
+    case GL_COPY_READ_BUFFER:     return 6;
+    case GL_COPY_WRITE_BUFFER:    return 7;
+    default:                      return -1;
+  }
+}
+
+static int getTextureSlot(const GLenum target)
+{
+  switch (target)
+  {
+    case GL_TEXTURE_2D:       return 0;
+    case GL_TEXTURE_2D_ARRAY: return 1;
+    case GL_TEXTURE_CUBE_MAP: return 2;
+    case GL_TEXTURE_3D:       return 3;
+    default:                  return -1;
+  }
+}
+
+void kdr::gfx::StateCache::invalidate()
+{
+  this->program     = UNKNOWN;
+  this->vertexArray = UNKNOWN;
+  this->activeUnit  = UNKNOWN;
+  for (GLuint& buffer : this->buffers)
+  {
+    buffer = UNKNOWN;
+  }
+  for (GLuint (&unit)[TEXTURE_TARGET_COUNT] : this->textures)
+  {
+    for (GLuint& texture : unit)
+    {
+      texture = UNKNOWN;
+    }
+  }
+}
+
+void kdr::gfx::StateCache::useProgram(const GLuint programID)
+{
+  if (this->program == programID)
+  {
+    this->stats.elided++;
+    return;
+  }
+  glUseProgram(programID);
+  this->program = programID;
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::bindVertexArray(const GLuint vaoID)
+{
+  if (this->vertexArray == vaoID)
+  {
+    this->stats.elided++;
+    return;
+  }
+  glBindVertexArray(vaoID);
+  this->vertexArray = vaoID;
+  // The element buffer binding belongs to the VAO
+  this->buffers[getBufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::bindBuffer(const GLenum target, const GLuint bufferID)
+{
+  const int slot = getBufferSlot(target);
+  if (slot >= 0 && this->buffers[slot] == bufferID)
+  {
+    this->stats.elided++;
+    return;
+  }
+  glBindBuffer(target, bufferID);
+  if (slot >= 0)
+  {
+    this->buffers[slot] = bufferID;
+  }
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::bindBufferBase(const GLenum target, const GLuint index, const GLuint bufferID)
+{
+  // Also replaces the generic binding of the target
+  glBindBufferBase(target, index, bufferID);
+  const int slot = getBufferSlot(target);
+  if (slot >= 0)
+  {
+    this->buffers[slot] = bufferID;
+  }
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::activeTexture(const GLenum unit)
+{
+  if (this->activeUnit == unit)
+  {
+    this->stats.elided++;
+    return;
+  }
+  glActiveTexture(unit);
+  this->activeUnit = unit;
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::bindTexture(const GLenum target, const GLuint textureID)
+{
+  const int unit = (int)this->activeUnit - GL_TEXTURE0;
+  const int slot = getTextureSlot(target);
+  const bool tracked = unit >= 0 && unit < TEXTURE_UNIT_COUNT && slot >= 0;
+  if (tracked && this->textures[unit][slot] == textureID)
+  {
+    this->stats.elided++;
+    return;
+  }
+  glBindTexture(target, textureID);
+  if (tracked)
+  {
+    this->textures[unit][slot] = textureID;
+  }
+  this->stats.issued++;
+}
+
+void kdr::gfx::StateCache::forgetProgram(const GLuint programID)
+{
+  // A deleted program stays in use until another one replaces it
+  if (this->program == programID)
+  {
+    this->program = UNKNOWN;
+  }
+}
+
+void kdr::gfx::StateCache::forgetVertexArray(const GLuint vaoID)
+{
+  if (this->vertexArray == vaoID)
+  {
+    this->vertexArray = 0;
+    this->buffers[getBufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+  }
+}
+
+void kdr::gfx::StateCache::forgetBuffer(const GLuint bufferID)
+{
+  for (GLuint& buffer : this->buffers)
+  {
+    if (buffer == bufferID)
+    {
+      buffer = 0;
+    }
+  }
+}
+
+void kdr::gfx::StateCache::forgetTexture(const GLuint textureID)
+{
+  for (GLuint (&unit)[TEXTURE_TARGET_COUNT] : this->textures)
+  {
+    for (GLuint& texture : unit)
+    {
+      if (texture == textureID)
+      {
+        texture = 0;
+      }
+    }
+  }
+}
+
+kdr::gfx::StateCache& kdr::gfx::getStateCache()
+{
+  // OpenGL contexts are current per thread, so one cache per thread follows them
+  thread_local kdr::gfx::StateCache cache;
+  return cache;
+}
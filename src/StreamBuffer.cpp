@@ -0,0 +1,117 @@
+#include "Kedarium/StreamBuffer.hpp"
+
+// Upper bound of a single fence wait, in nanoseconds
+static constexpr GLuint64 FENCE_WAIT_TIMEOUT {1000000};
+
+kdr::gfx::StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr regionSize)
+: target(target), regionSize(regionSize)
+{
+  const GLsizeiptr size = regionSize * REGION_COUNT;
+
+  glGenBuffers(1, &this->ID);
+  this->Bind();
+  if (GLEW_ARB_buffer_storage || GLEW_VERSION_4_4)
+  {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(this->target, size, NULL, flags);
+    this->mapping    = (char*)glMapBufferRange(this->target, 0, size, flags);
+    this->persistent = this->mapping != NULL;
+  }
+  if (!this->persistent)
+  {
+    glBufferData(this->target, size, NULL, GL_STREAM_DRAW);
+  }
+  this->Unbind();
+}
+
+void kdr::gfx::StreamBuffer::BeginFrame()
+{
+  this->region = (this->region + 1) % REGION_COUNT;
+  this->head   = 0;
+
+  GLsync& fence = this->fences[this->region];
+  if (fence != NULL)
+  {
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+      this->stallCount++;
+      do
+      {
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT);
+      } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fence = NULL;
+  }
+
+  if (this->persistent)
+  {
+    this->regionData = this->mapping + this->region * this->regionSize;
+    return;
+  }
+
+  // The fence already guarantees the GPU is done with this region
+  this->Bind();
+  this->regionData = (char*)glMapBufferRange(
+    this->target,
+    this->region * this->regionSize,
+    this->regionSize,
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT
+  );
+}
+
+void* kdr::gfx::StreamBuffer::Allocate(GLsizeiptr size, GLintptr& offset, GLsizeiptr alignment)
+{
+  if (this->regionData == NULL) return NULL;
+
+  const GLintptr regionStart = this->region * this->regionSize;
+  const GLintptr start       = (regionStart + this->head + alignment - 1) / alignment * alignment;
+  if (start + size > regionStart + this->regionSize) return NULL;
+
+  this->head = start + size - regionStart;
+  offset     = start;
+  return this->regionData + (start - regionStart);
+}
+
+void kdr::gfx::StreamBuffer::Flush()
+{
+  // Coherent persistent mappings are visible to the GPU without any call
+  if (this->persistent || this->regionData == NULL) return;
+
+  this->Bind();
+  if (this->head > 0)
+  {
+    glFlushMappedBufferRange(this->target, 0, this->head);
+  }
+  glUnmapBuffer(this->target);
+  this->regionData = NULL;
+}
+
+void kdr::gfx::StreamBuffer::EndFrame()
+{
+  this->Flush();
+  this->fences[this->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void kdr::gfx::StreamBuffer::Delete()
+{
+  if (this->persistent || this->regionData != NULL)
+  {
+    this->Bind();
+    glUnmapBuffer(this->target);
+  }
+  this->mapping    = NULL;
+  this->regionData = NULL;
+
+  for (GLsync& fence : this->fences)
+  {
+    if (fence != NULL)
+    {
+      glDeleteSync(fence);
+      fence = NULL;
+    }
+  }
+  glDeleteBuffers(1, &this->ID);
+  kdr::gfx::getStateCache().forgetBuffer(this->ID);
+}
@@ -0,0 +1,241 @@
+#include "Kedarium/TextureAtlas.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "Kedarium/Graphics.hpp"
+
+kdr::gfx::SkylinePacker::SkylinePacker(const int width, const int height)
+: width(width), height(height)
+{
+  this->clear();
+}
+
+bool kdr::gfx::SkylinePacker::pack(const int width, const int height, int& x, int& y)
+{
+  size_t bestIndex = this->skyline.size();
+  int    bestY     = std::numeric_limits<int>::max();
+  for (size_t i = 0; i < this->skyline.size(); i++)
+  {
+    // Segments are sorted by x, so the first of equally low fits is the leftmost
+    const int restY = this->_fit(i, width);
+    if (restY >= 0 && restY + height <= this->height && restY < bestY)
+    {
+      bestIndex = i;
+      bestY     = restY;
+    }
+  }
+  if (bestIndex == this->skyline.size()) return false;
+
+  x = this->skyline[bestIndex].x;
+  y = bestY;
+
+  // Raise the skyline under the new rectangle
+  const int right = x + width;
+  this->skyline.insert(this->skyline.begin() + bestIndex, {x, y + height, width});
+  size_t next = bestIndex + 1;
+  while (next < this->skyline.size() && this->skyline[next].x < right)
+  {
+    Segment& segment = this->skyline[next];
+    const int overlap = right - segment.x;
+    if (overlap < segment.width)
+    {
+      segment.x     += overlap;
+      segment.width -= overlap;
+      break;
+    }
+    this->skyline.erase(this->skyline.begin() + next);
+  }
+
+  // Merge neighbours left at the same height
+  for (size_t i = 0; i + 1 < this->skyline.size();)
+  {
+    if (this->skyline[i].y == this->skyline[i + 1].y)
+    {
+      this->skyline[i].width += this->skyline[i + 1].width;
+      this->skyline.erase(this->skyline.begin() + i + 1);
+    }
+    else
+    {
+      i++;
+    }
+  }
+  return true;
+}
+
+void kdr::gfx::SkylinePacker::clear()
+{
+  this->skyline.clear();
+  this->skyline.push_back({0, 0, this->width});
+}
+
+int kdr::gfx::SkylinePacker::_fit(const size_t index, const int width) const
+{
+  if (this->skyline[index].x + width > this->width) return -1;
+
+  int y         = 0;
+  int remaining = width;
+  for (size_t i = index; remaining > 0; i++)
+  {
+    y          = std::max(y, this->skyline[i].y);
+    remaining -= this->skyline[i].width;
+  }
+  return y;
+}
+
+kdr::gfx::TextureAtlas::TextureAtlas(
+  GLenum type,
+  int width,
+  int height,
+  int maxLayers,
+  int padding,
+  const kdr::gfx::SamplerState& sampler
+)
+: type(type), width(width), height(height), maxLayers(type == GL_TEXTURE_2D ? 1 : maxLayers), padding(padding), sampler(sampler)
+{}
+
+int kdr::gfx::TextureAtlas::Add(const std::string& imagePath)
+{
+  kdr::img::Image image;
+  if (!kdr::img::loadImage(imagePath, image, true)) return -1;
+
+  this->images.push_back(std::move(image));
+  this->regions.push_back({});
+  return this->images.size() - 1;
+}
+
+int kdr::gfx::TextureAtlas::Add(const GLubyte* pixels, int width, int height)
+{
+  kdr::img::Image image {width, height, 4};
+  std::copy_n(pixels, image.getSize(), image.getData());
+
+  this->images.push_back(std::move(image));
+  this->regions.push_back({});
+  return this->images.size() - 1;
+}
+
+bool kdr::gfx::TextureAtlas::Build()
+{
+  std::vector<size_t> order(this->images.size());
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](const size_t a, const size_t b) {
+    return this->images[a].getHeight() > this->images[b].getHeight();
+  });
+
+  bool packedAll = true;
+  std::vector<kdr::gfx::SkylinePacker> packers;
+  std::vector<std::vector<GLubyte>>    layers;
+  for (const size_t index : order)
+  {
+    const kdr::img::Image& image = this->images[index];
+    const int paddedWidth  = image.getWidth()  + this->padding * 2;
+    const int paddedHeight = image.getHeight() + this->padding * 2;
+
+    int x     {0};
+    int y     {0};
+    int layer {0};
+    while (layer < (int)packers.size() && !packers[layer].pack(paddedWidth, paddedHeight, x, y))
+    {
+      layer++;
+    }
+    if (layer == (int)packers.size())
+    {
+      if (layer == this->maxLayers)
+      {
+        packedAll = false;
+        continue;
+      }
+      packers.emplace_back(this->width, this->height);
+      if (!packers.back().pack(paddedWidth, paddedHeight, x, y))
+      {
+        // Larger than a whole layer
+        packers.pop_back();
+        packedAll = false;
+        continue;
+      }
+      layers.emplace_back((size_t)this->width * this->height * 4, 0);
+    }
+
+    x += this->padding;
+    y += this->padding;
+    GLubyte* pixels = layers[layer].data();
+    for (int row = 0; row < image.getHeight(); row++)
+    {
+      std::copy_n(
+        image.getData() + (size_t)row * image.getWidth() * 4,
+        image.getWidth() * 4,
+        pixels + ((size_t)(y + row) * this->width + x) * 4
+      );
+    }
+
+    // Repeat the edge texels into the padding, so that filtering at the
+    // edges of the image blends with the image instead of the empty layer
+    if (!image.isEmpty())
+    {
+      for (int row = 0; row < image.getHeight(); row++)
+      {
+        GLubyte* first = pixels + ((size_t)(y + row) * this->width + x) * 4;
+        GLubyte* last  = first + (size_t)(image.getWidth() - 1) * 4;
+        for (int i = 1; i <= this->padding; i++)
+        {
+          std::copy_n(first, 4, first - (size_t)i * 4);
+          std::copy_n(last, 4, last + (size_t)i * 4);
+        }
+      }
+
+      const size_t rowSize       = (size_t)this->width * 4;
+      const size_t paddedRowSize = (size_t)paddedWidth * 4;
+      GLubyte* bottom = pixels + ((size_t)y * this->width + x - this->padding) * 4;
+      GLubyte* top    = bottom + (size_t)(image.getHeight() - 1) * rowSize;
+      for (int i = 1; i <= this->padding; i++)
+      {
+        std::copy_n(bottom, paddedRowSize, bottom - i * rowSize);
+        std::copy_n(top, paddedRowSize, top + i * rowSize);
+      }
+    }
+
+    kdr::gfx::AtlasRegion& region = this->regions[index];
+    region.layer = layer;
+    region.uvMin = {(float)x / this->width, (float)y / this->height};
+    region.uvMax = {(float)(x + image.getWidth()) / this->width, (float)(y + image.getHeight()) / this->height};
+  }
+  this->layerCount = layers.size();
+  this->images.clear();
+  this->images.shrink_to_fit();
+
+  if (this->ID != 0)
+  {
+    this->Delete();
+  }
+  glGenTextures(1, &this->ID);
+  this->Bind();
+  kdr::gfx::applySampler(this->type, this->sampler);
+  if (this->type == GL_TEXTURE_2D_ARRAY)
+  {
+    glTexImage3D(this->type, 0, GL_RGBA8, this->width, this->height, this->layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    for (int layer = 0; layer < this->layerCount; layer++)
+    {
+      glTexSubImage3D(this->type, 0, 0, 0, layer, this->width, this->height, 1, GL_RGBA, GL_UNSIGNED_BYTE, layers[layer].data());
+    }
+  }
+  else
+  {
+    glTexImage2D(this->type, 0, GL_RGBA8, this->width, this->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, layers.empty() ? NULL : layers[0].data());
+  }
+  if (kdr::gfx::isMipmapFilter(this->sampler.minFilter))
+  {
+    glGenerateMipmap(this->type);
+  }
+  this->Unbind();
+
+  return packedAll;
+}
+
+void kdr::gfx::TextureAtlas::TextureUnit(kdr::gfx::Shader& shader, const std::string& uniform, GLuint unit)
+{
+  shader.Use();
+  shader.setInt(shader.getUniformLocation(uniform), unit);
+}
@@ -0,0 +1,101 @@
+#include "Kedarium/TextureCache.hpp"
+
+void kdr::gfx::TextureCache::setBudget(const size_t budget)
+{
+  this->budget = budget;
+  this->_evict(this->budget);
+}
+
+size_t kdr::gfx::TextureCache::estimateSize(int width, int height, const size_t bytesPerTexel, const bool isMipmapped)
+{
+  size_t size = (size_t)width * height * bytesPerTexel;
+  while (isMipmapped && (width > 1 || height > 1))
+  {
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+    size  += (size_t)width * height * bytesPerTexel;
+  }
+  return size;
+}
+
+kdr::gfx::Texture* kdr::gfx::TextureCache::Acquire(const std::string& imagePath, GLenum type)
+{
+  std::string key = imagePath;
+  key += '|' + std::to_string(type);
+
+  const auto it = this->entries.find(key);
+  if (it != this->entries.end())
+  {
+    Entry& entry = it->second;
+    if (entry.refCount++ == 0)
+    {
+      this->unused.erase(entry.unusedPosition);
+    }
+    this->stats.hits++;
+    return entry.texture.get();
+  }
+
+  this->stats.misses++;
+  Entry entry;
+  entry.texture.reset(new kdr::gfx::Texture(imagePath, type, GL_TEXTURE0));
+  // Failed loads are not cached, so a fixed file is picked up by the next call
+  if (entry.texture->getWidth() == 0)
+  {
+    entry.texture->Delete();
+    return NULL;
+  }
+  entry.refCount = 1;
+  entry.size = entry.texture->getMemorySize();
+
+  kdr::gfx::Texture* texture = entry.texture.get();
+  this->usage += entry.size;
+  this->keys.emplace(texture, key);
+  this->entries.emplace(std::move(key), std::move(entry));
+
+  this->_evict(this->budget);
+  return texture;
+}
+
+void kdr::gfx::TextureCache::Release(const kdr::gfx::Texture* texture)
+{
+  const auto key = this->keys.find(texture);
+  if (key == this->keys.end()) return;
+
+  Entry& entry = this->entries.at(key->second);
+  if (entry.refCount == 0 || --entry.refCount > 0) return;
+
+  entry.unusedPosition = this->unused.insert(this->unused.end(), key->second);
+  this->_evict(this->budget);
+}
+
+void kdr::gfx::TextureCache::Trim()
+{
+  this->_evict(0);
+}
+
+void kdr::gfx::TextureCache::Delete()
+{
+  for (std::pair<const std::string, Entry>& entry : this->entries)
+  {
+    entry.second.texture->Delete();
+  }
+  this->entries.clear();
+  this->keys.clear();
+  this->unused.clear();
+  this->usage = 0;
+}
+
+void kdr::gfx::TextureCache::_evict(const size_t budget)
+{
+  while (this->usage > budget && !this->unused.empty())
+  {
+    const auto it = this->entries.find(this->unused.front());
+    this->unused.pop_front();
+
+    it->second.texture->Delete();
+    this->usage -= it->second.size;
+    this->keys.erase(it->second.texture.get());
+    this->entries.erase(it);
+    this->stats.evictions++;
+  }
+}
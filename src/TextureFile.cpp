@@ -0,0 +1,186 @@
+#include "Kedarium/TextureFile.hpp"
+
+#include <string.h>
+#include <fstream>
+#include <iostream>
+
+#include "Kedarium/Compression.hpp"
+#include "Kedarium/File.hpp"
+#include "Kedarium/Mipmap.hpp"
+
+// "KDTX"
+constexpr uint32_t TEXTURE_FILE_MAGIC   {0x5854444b};
+constexpr uint32_t TEXTURE_FILE_VERSION {1};
+constexpr uint32_t LEVEL_ALIGNMENT      {16};
+
+bool kdr::img::isCompressed(const kdr::img::PixelFormat format)
+{
+  return format != kdr::img::PixelFormat::RGBA8 && format != kdr::img::PixelFormat::SRGB8_ALPHA8;
+}
+
+GLenum kdr::img::getInternalFormat(const kdr::img::PixelFormat format)
+{
+  switch (format)
+  {
+    case kdr::img::PixelFormat::RGBA8:             return GL_RGBA8;
+    case kdr::img::PixelFormat::SRGB8_ALPHA8:      return GL_SRGB8_ALPHA8;
+    case kdr::img::PixelFormat::BC1:               return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case kdr::img::PixelFormat::BC1_SRGB:          return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+    case kdr::img::PixelFormat::BC3:               return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case kdr::img::PixelFormat::BC3_SRGB:          return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case kdr::img::PixelFormat::BC7:               return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case kdr::img::PixelFormat::BC7_SRGB:          return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case kdr::img::PixelFormat::ETC2_RGB8:         return GL_COMPRESSED_RGB8_ETC2;
+    case kdr::img::PixelFormat::ETC2_SRGB8:        return GL_COMPRESSED_SRGB8_ETC2;
+    case kdr::img::PixelFormat::ETC2_RGBA8:        return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    case kdr::img::PixelFormat::ETC2_SRGB8_ALPHA8: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+  }
+  return GL_NONE;
+}
+
+size_t kdr::img::getLevelSize(const kdr::img::PixelFormat format, const int width, const int height)
+{
+  switch (format)
+  {
+    case kdr::img::PixelFormat::RGBA8:
+    case kdr::img::PixelFormat::SRGB8_ALPHA8:
+      return (size_t)width * height * 4;
+    case kdr::img::PixelFormat::BC1:
+    case kdr::img::PixelFormat::BC1_SRGB:
+    case kdr::img::PixelFormat::ETC2_RGB8:
+    case kdr::img::PixelFormat::ETC2_SRGB8:
+      return (size_t)kdr::img::getBlockCount(width) * kdr::img::getBlockCount(height) * 8;
+    default:
+      return (size_t)kdr::img::getBlockCount(width) * kdr::img::getBlockCount(height) * 16;
+  }
+}
+
+/**
+ * Parses a texture file, copying its levels out of the file view.
+ */
+static bool parseTextureFile(const std::string& path, const char* data, const size_t size, kdr::img::TextureFile& textureFile)
+{
+  // Magic, version, format, width, height, level count
+  uint32_t header[6] {0, 0, 0, 0, 0, 0};
+  if (size >= sizeof(header)) memcpy(header, data, sizeof(header));
+  if (
+    header[0] != TEXTURE_FILE_MAGIC ||
+    header[1] != TEXTURE_FILE_VERSION ||
+    header[2] > (uint32_t)kdr::img::PixelFormat::ETC2_SRGB8_ALPHA8 ||
+    header[3] == 0 || header[3] > INT32_MAX ||
+    header[4] == 0 || header[4] > INT32_MAX ||
+    header[5] == 0 ||
+    // Checked before anything is allocated from it
+    header[5] > (uint32_t)kdr::img::getMipLevelCount((int)header[3], (int)header[4])
+  )
+  {
+    std::cerr << "Invalid texture file header (" << path << ")!\n";
+    return false;
+  }
+
+  std::vector<uint32_t> table((size_t)header[5] * 2);
+  if (table.size() * sizeof(uint32_t) > size - sizeof(header))
+  {
+    std::cerr << "Invalid texture file level table (" << path << ")!\n";
+    return false;
+  }
+  memcpy(table.data(), data + sizeof(header), table.size() * sizeof(uint32_t));
+
+  textureFile.format = (kdr::img::PixelFormat)header[2];
+  textureFile.width  = (int)header[3];
+  textureFile.height = (int)header[4];
+  textureFile.levels.assign(header[5], std::vector<uint8_t>());
+
+  int width  = textureFile.width;
+  int height = textureFile.height;
+  for (uint32_t level = 0; level < header[5]; level++)
+  {
+    const uint32_t offset    = table[level * 2];
+    const uint32_t levelSize = table[level * 2 + 1];
+    if (levelSize != kdr::img::getLevelSize(textureFile.format, width, height))
+    {
+      std::cerr << "Invalid texture file level size (" << path << ")!\n";
+      return false;
+    }
+    if (offset > size || levelSize > size - offset)
+    {
+      std::cerr << "Failed to read texture file level " << level << " (" << path << ")!\n";
+      return false;
+    }
+    textureFile.levels[level].assign(data + offset, data + offset + levelSize);
+
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+  return true;
+}
+
+bool kdr::img::isTextureFile(const std::string& path)
+{
+  // Only the magic is read
+  kdr::file::ChunkReader file(sizeof(uint32_t));
+  std::string_view       magic;
+  return
+    file.open(path) &&
+    file.read(magic) &&
+    magic.size() == sizeof(uint32_t) &&
+    memcmp(magic.data(), &TEXTURE_FILE_MAGIC, sizeof(uint32_t)) == 0;
+}
+
+bool kdr::img::loadTextureFile(const std::string& path, kdr::img::TextureFile& textureFile)
+{
+  kdr::file::FileView file;
+  if (!file.open(path))
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+  return parseTextureFile(path, file.getData(), file.getSize(), textureFile);
+}
+
+bool kdr::img::saveTextureFile(const std::string& path, const kdr::img::TextureFile& textureFile)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::cerr << "Failed to open file (" << path << ")!\n";
+    return false;
+  }
+
+  const uint32_t levelCount = (uint32_t)textureFile.levels.size();
+  const uint32_t header[6] {
+    TEXTURE_FILE_MAGIC,
+    TEXTURE_FILE_VERSION,
+    (uint32_t)textureFile.format,
+    (uint32_t)textureFile.width,
+    (uint32_t)textureFile.height,
+    levelCount,
+  };
+
+  std::vector<uint32_t> table(levelCount * 2);
+  uint32_t offset = sizeof(header) + table.size() * sizeof(uint32_t);
+  for (uint32_t level = 0; level < levelCount; level++)
+  {
+    offset = (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+    table[level * 2]     = offset;
+    table[level * 2 + 1] = (uint32_t)textureFile.levels[level].size();
+    offset += table[level * 2 + 1];
+  }
+
+  file.write((const char*)header, sizeof(header));
+  file.write((const char*)table.data(), table.size() * sizeof(uint32_t));
+
+  const char padding[LEVEL_ALIGNMENT] {};
+  for (uint32_t level = 0; level < levelCount; level++)
+  {
+    file.write(padding, table[level * 2] - (uint32_t)file.tellp());
+    file.write((const char*)textureFile.levels[level].data(), textureFile.levels[level].size());
+  }
+
+  if (!file)
+  {
+    std::cerr << "Failed to write file (" << path << ")!\n";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,326 @@
+#include "Kedarium/TextureStreamer.hpp"
+
+#include <algorithm>
+
+/**
+ * Gets the size of the first levels of an RGBA8 mip chain.
+ */
+static size_t getChainSize(int width, int height, const int levelCount)
+{
+  size_t size {0};
+  for (int level = 0; level < levelCount; level++)
+  {
+    size  += (size_t)width * height * 4;
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+  return size;
+}
+
+kdr::gfx::TextureStreamer::TextureStreamer(size_t uploadBudget, unsigned int workerCount, const kdr::gfx::SamplerState& sampler)
+: uploadBudget(uploadBudget), sampler(sampler)
+{
+  if (workerCount == 0)
+  {
+    const unsigned int threadCount = std::thread::hardware_concurrency();
+    workerCount = threadCount > 1 ? threadCount - 1 : 1;
+  }
+  for (unsigned int i = 0; i < workerCount; i++)
+  {
+    this->workers.emplace_back(&kdr::gfx::TextureStreamer::_work, this);
+  }
+
+  // Mid-gray until the real texture has arrived
+  const GLubyte placeholder[2 * 2 * 4] {
+    128, 128, 128, 255,  128, 128, 128, 255,
+    128, 128, 128, 255,  128, 128, 128, 255,
+  };
+  glGenTextures(1, &this->placeholderID);
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  state.bindTexture(GL_TEXTURE_2D, this->placeholderID);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+  state.bindTexture(GL_TEXTURE_2D, 0);
+}
+
+kdr::gfx::TextureStreamer::~TextureStreamer()
+{
+  this->_stop();
+}
+
+GLuint kdr::gfx::TextureStreamer::getID(const Handle handle) const
+{
+  const Job& job = *this->jobs[handle];
+  return job.stage == Stage::Ready ? job.textureID : this->placeholderID;
+}
+
+bool kdr::gfx::TextureStreamer::isReady(const Handle handle) const
+{
+  return this->jobs[handle]->stage == Stage::Ready;
+}
+
+kdr::gfx::TextureStreamer::Handle kdr::gfx::TextureStreamer::Request(const std::string& imagePath)
+{
+  this->jobs.emplace_back(new Job);
+  Job* job = this->jobs.back().get();
+  job->path = imagePath;
+
+  this->activeJobs.push_back(job);
+  this->_enqueue(job);
+  return this->jobs.size() - 1;
+}
+
+void kdr::gfx::TextureStreamer::Update()
+{
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  size_t budget = this->uploadBudget;
+
+  for (size_t i = 0; i < this->activeJobs.size();)
+  {
+    Job& job = *this->activeJobs[i];
+    switch (job.stage.load())
+    {
+      case Stage::Mapping:
+      {
+        const GLsizeiptr size = getChainSize(job.width, job.height, job.levelCount);
+        glGenBuffers(1, &job.pboID);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, job.pboID);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        job.mapping = (GLubyte*)glMapBufferRange(
+          GL_PIXEL_UNPACK_BUFFER,
+          0,
+          size,
+          GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        );
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (job.mapping == NULL)
+        {
+          job.stage = Stage::Failed;
+          continue;
+        }
+        job.stage = Stage::Decoding;
+        this->_enqueue(&job);
+        break;
+      }
+
+      case Stage::Uploading:
+      {
+        if (budget == 0) break;
+
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, job.pboID);
+        if (job.mapping != NULL)
+        {
+          // The pixel buffer can only be read by the GPU once unmapped
+          glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+          job.mapping = NULL;
+
+          glGenTextures(1, &job.textureID);
+          state.bindTexture(GL_TEXTURE_2D, job.textureID);
+          kdr::gfx::applySampler(GL_TEXTURE_2D, this->sampler);
+          glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, job.levelCount - 1);
+          for (int level = 0; level < job.levelCount; level++)
+          {
+            glTexImage2D(
+              GL_TEXTURE_2D,
+              level,
+              GL_RGBA8,
+              std::max(1, job.width >> level),
+              std::max(1, job.height >> level),
+              0,
+              GL_RGBA,
+              GL_UNSIGNED_BYTE,
+              NULL
+            );
+          }
+        }
+
+        // At least one row per frame, however small the budget
+        state.bindTexture(GL_TEXTURE_2D, job.textureID);
+        do
+        {
+          const int    levelWidth  = std::max(1, job.width >> job.uploadedLevel);
+          const int    levelHeight = std::max(1, job.height >> job.uploadedLevel);
+          const size_t rowBytes    = (size_t)levelWidth * 4;
+          int rows = budget / rowBytes;
+          rows = rows < 1 ? 1 : rows;
+          rows = rows > levelHeight - job.uploadedRows ? levelHeight - job.uploadedRows : rows;
+
+          glTexSubImage2D(
+            GL_TEXTURE_2D,
+            job.uploadedLevel,
+            0,
+            job.uploadedRows,
+            levelWidth,
+            rows,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            (const void*)(job.levelOffset + job.uploadedRows * rowBytes)
+          );
+          job.uploadedRows += rows;
+          budget -= (size_t)rows * rowBytes < budget ? (size_t)rows * rowBytes : budget;
+
+          if (job.uploadedRows == levelHeight)
+          {
+            job.levelOffset  += (size_t)levelHeight * rowBytes;
+            job.uploadedRows  = 0;
+            job.uploadedLevel++;
+          }
+        } while (budget > 0 && job.uploadedLevel < job.levelCount);
+
+        if (job.uploadedLevel == job.levelCount)
+        {
+          job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+          this->_releaseBuffer(job);
+          job.stage = Stage::Fenced;
+        }
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        break;
+      }
+
+      case Stage::Fenced:
+      {
+        const GLenum status = glClientWaitSync(job.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+        glDeleteSync(job.fence);
+        job.fence = NULL;
+        job.stage = Stage::Ready;
+        this->activeJobs.erase(this->activeJobs.begin() + i);
+        continue;
+      }
+
+      case Stage::Failed:
+      {
+        this->_releaseBuffer(job);
+        this->activeJobs.erase(this->activeJobs.begin() + i);
+        continue;
+      }
+
+      default:
+        break;
+    }
+    i++;
+  }
+}
+
+void kdr::gfx::TextureStreamer::Delete()
+{
+  // Workers may still be writing into mapped pixel buffers
+  this->_stop();
+
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  for (const std::unique_ptr<Job>& job : this->jobs)
+  {
+    this->_releaseBuffer(*job);
+    if (job->fence != NULL)
+    {
+      glDeleteSync(job->fence);
+      job->fence = NULL;
+    }
+    if (job->textureID != 0)
+    {
+      glDeleteTextures(1, &job->textureID);
+      state.forgetTexture(job->textureID);
+    }
+  }
+  this->jobs.clear();
+  this->activeJobs.clear();
+
+  glDeleteTextures(1, &this->placeholderID);
+  state.forgetTexture(this->placeholderID);
+}
+
+void kdr::gfx::TextureStreamer::_work()
+{
+  while (true)
+  {
+    Job* job {NULL};
+    {
+      std::unique_lock<std::mutex> lock(this->workMutex);
+      this->workCondition.wait(lock, [this]() {
+        return this->stopping || !this->workQueue.empty();
+      });
+      if (this->stopping) return;
+
+      job = this->workQueue.front();
+      this->workQueue.pop_front();
+    }
+
+    if (job->stage == Stage::ReadingHeader)
+    {
+      const bool isValid = kdr::img::getImageSize(job->path, job->width, job->height);
+      if (isValid && kdr::gfx::isMipmapFilter(this->sampler.minFilter))
+      {
+        job->levelCount = kdr::img::getMipLevelCount(job->width, job->height);
+      }
+      job->stage = isValid ? Stage::Mapping : Stage::Failed;
+      continue;
+    }
+
+    // Without mips, decoded straight into the mapped pixel buffer. The mip
+    // filter reads its input many times, so it gets a copy in regular memory
+    // rather than reading back the write-combined mapping.
+    kdr::img::Image image;
+    const bool isDecoded = job->levelCount == 1 ?
+      kdr::img::loadImage(job->path, job->mapping, (size_t)job->width * job->height * 4, image, true) :
+      kdr::img::loadImage(job->path, image, true);
+    if (!isDecoded || image.getWidth() != job->width || image.getHeight() != job->height)
+    {
+      job->stage = Stage::Failed;
+      continue;
+    }
+
+    if (job->levelCount > 1)
+    {
+      std::vector<std::vector<uint8_t>> levels;
+      kdr::img::generateMipChain(image.getData(), job->width, job->height, kdr::img::MipFilter::Box, false, levels);
+      GLubyte* target = job->mapping;
+      for (const std::vector<uint8_t>& level : levels)
+      {
+        target = std::copy(level.begin(), level.end(), target);
+      }
+    }
+    job->stage = Stage::Uploading;
+  }
+}
+
+void kdr::gfx::TextureStreamer::_stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workMutex);
+    this->stopping = true;
+  }
+  this->workCondition.notify_all();
+  for (std::thread& worker : this->workers)
+  {
+    worker.join();
+  }
+  this->workers.clear();
+}
+
+void kdr::gfx::TextureStreamer::_enqueue(Job* job)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workMutex);
+    this->workQueue.push_back(job);
+  }
+  this->workCondition.notify_one();
+}
+
+void kdr::gfx::TextureStreamer::_releaseBuffer(Job& job)
+{
+  if (job.pboID == 0) return;
+
+  kdr::gfx::StateCache& state = kdr::gfx::getStateCache();
+  if (job.mapping != NULL)
+  {
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, job.pboID);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    job.mapping = NULL;
+  }
+  glDeleteBuffers(1, &job.pboID);
+  state.forgetBuffer(job.pboID);
+  job.pboID = 0;
+}
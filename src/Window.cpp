@@ -13,6 +13,11 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height)
 
 kdr::Window::~Window()
 {
+  if (this->frameConstantsBuffer != NULL)
+  {
+    this->frameConstantsBuffer->Delete();
+    delete this->frameConstantsBuffer;
+  }
   glfwDestroyWindow(this->glfwWindow);
 }
 
@@ -104,6 +109,10 @@ bool kdr::Window::_initializeGlew()
 bool kdr::Window::_initializeOpenGLSettings()
 {
   glPointSize(5.f);
+  this->frameConstantsBuffer = new kdr::gfx::UniformBuffer(
+    sizeof(kdr::gfx::FrameConstants),
+    kdr::gfx::FRAME_CONSTANTS_BINDING
+  );
   return true;
 }
 
@@ -118,18 +127,39 @@ void kdr::Window::_initialize()
 void kdr::Window::_updateBoundCamera()
 {
   if (this->boundCamera == NULL) return;
-  if (this->boundShaderID == 0) return;
 
   this->boundCamera->handleMovement(this->glfwWindow);
   this->boundCamera->handleMouseMovement(this->glfwWindow);
   this->boundCamera->updateMatrix();
-  this->boundCamera->applyMatrix(this->boundShaderID, "cameraMatrix");
+
+  if (this->boundShaderID == 0 || this->cameraMatrixLocation == -1) return;
+  this->boundCamera->applyMatrix(this->cameraMatrixLocation);
+}
+
+void kdr::Window::_updateFrameConstants()
+{
+  kdr::gfx::FrameConstants constants;
+  constants.view           = kdr::space::Mat4 {1.f};
+  constants.projection     = kdr::space::Mat4 {1.f};
+  constants.viewProjection = kdr::space::Mat4 {1.f};
+  constants.cameraPosition = {0.f, 0.f, 0.f, 1.f};
+  constants.time           = glfwGetTime();
+
+  if (this->boundCamera != NULL)
+  {
+    constants.view           = this->boundCamera->getView();
+    constants.projection     = this->boundCamera->getProjection();
+    constants.viewProjection = this->boundCamera->getMatrix();
+    constants.cameraPosition = {this->boundCamera->getEyePosition(), 1.f};
+  }
+  this->frameConstantsBuffer->Update(&constants, sizeof(constants));
 }
 
 void kdr::Window::_update()
 {
   glfwPollEvents();
   this->_updateBoundCamera();
+  this->_updateFrameConstants();
   this->update();
 }
 
@@ -137,5 +167,7 @@ void kdr::Window::_render()
 {
   glClear(GL_COLOR_BUFFER_BIT);
   this->render();
+  this->renderQueue.Execute();
+  this->renderQueue.Clear();
   glfwSwapBuffers(this->glfwWindow);
 }
@@ -0,0 +1,144 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Kedarium/Pixel.hpp"
+#include "Kedarium/Simd.hpp"
+
+// Settings
+constexpr size_t MAX_TAIL_COUNT {40};
+// Many vectors wide and odd, so the vector loop and the scalar tail both run
+constexpr size_t LARGE_COUNT    {4096 + 13};
+
+int mismatchCount {0};
+
+/**
+ * Compares a kernel result with the scalar reference bit for bit.
+ */
+template <typename T>
+void check(const char* name, const size_t count, const std::vector<T>& result, const std::vector<T>& reference)
+{
+  if (result.empty() || memcmp(result.data(), reference.data(), result.size() * sizeof(T)) == 0) return;
+  if (mismatchCount++ < 10)
+  {
+    std::cerr << "MISMATCH in " << name << " over " << count << " pixels with the scalar reference!\n";
+  }
+}
+
+float decodeSRGB(const uint8_t value)
+{
+  const float color = value / 255.f;
+  return color <= 0.04045f ? color / 12.92f : powf((color + 0.055f) / 1.055f, 2.4f);
+}
+
+uint8_t encodeSRGB(const float value)
+{
+  // Quantized to the 4096 steps of the library's table first
+  const float clamped = value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+  const float color   = (float)(int)(clamped * 4095.f + 0.5f) / 4095;
+  const float encoded = color <= 0.0031308f ? color * 12.92f : 1.055f * powf(color, 1.f / 2.4f) - 0.055f;
+  return (uint8_t)(encoded * 255.f + 0.5f);
+}
+
+/**
+ * Checks every kernel against its scalar reference over count pixels.
+ */
+void checkKernels(const size_t count, std::mt19937& rng)
+{
+  std::vector<uint8_t> rgb(count * 3);
+  std::vector<uint8_t> rgba(count * 4);
+  std::vector<float>   linear(count * 4);
+  for (uint8_t& value : rgb) value = rng();
+  for (uint8_t& value : rgba) value = rng();
+  // Slightly out of range, as filtered values can be
+  std::uniform_real_distribution<float> unit {-0.05f, 1.05f};
+  for (float& value : linear) value = unit(rng);
+
+  std::vector<uint8_t> output(count * 4);
+  std::vector<uint8_t> reference(count * 4);
+  kdr::img::expandRGBToRGBA(rgb.data(), output.data(), count);
+  for (size_t i = 0; i < count; i++)
+  {
+    memcpy(&reference[i * 4], &rgb[i * 3], 3);
+    reference[i * 4 + 3] = 0xff;
+  }
+  check("expandRGBToRGBA()", count, output, reference);
+
+  kdr::img::swapRedBlue(rgba.data(), output.data(), count);
+  for (size_t i = 0; i < count; i++)
+  {
+    reference[i * 4]     = rgba[i * 4 + 2];
+    reference[i * 4 + 1] = rgba[i * 4 + 1];
+    reference[i * 4 + 2] = rgba[i * 4];
+    reference[i * 4 + 3] = rgba[i * 4 + 3];
+  }
+  check("swapRedBlue()", count, output, reference);
+
+  kdr::img::premultiplyAlpha(rgba.data(), output.data(), count);
+  for (size_t i = 0; i < rgba.size(); i++)
+  {
+    const int alpha = rgba[i | 3];
+    reference[i] = i % 4 == 3 ? alpha : (uint8_t)lround(rgba[i] * alpha / 255.0);
+  }
+  check("premultiplyAlpha()", count, output, reference);
+
+  for (const bool isSRGB : {false, true})
+  {
+    std::vector<float> floatOutput(count * 4);
+    std::vector<float> floatReference(count * 4);
+    kdr::img::decodePixels(rgba.data(), floatOutput.data(), count, isSRGB);
+    for (size_t i = 0; i < rgba.size(); i++)
+    {
+      floatReference[i] = isSRGB && i % 4 != 3 ? decodeSRGB(rgba[i]) : rgba[i] / 255.f;
+    }
+    check(isSRGB ? "decodePixels() from sRGB" : "decodePixels()", count, floatOutput, floatReference);
+
+    kdr::img::encodePixels(linear.data(), output.data(), count, isSRGB);
+    for (size_t i = 0; i < linear.size(); i++)
+    {
+      const float value = linear[i] > 0.f ? (linear[i] < 1.f ? linear[i] : 1.f) : 0.f;
+      reference[i] = isSRGB && i % 4 != 3 ? encodeSRGB(linear[i]) : (uint8_t)(value * 255.f + 0.5f);
+    }
+    check(isSRGB ? "encodePixels() to sRGB" : "encodePixels()", count, output, reference);
+  }
+
+  // Rows of count pixels, 1 to 5 of them so odd heights keep a middle row in place
+  const int height = (int)(count % 5) + 1;
+  const size_t rowSize = count * 4;
+  std::vector<uint8_t> rows(rowSize * height);
+  for (uint8_t& value : rows) value = rng();
+  output = rows;
+  kdr::img::flipRows(output.data(), rowSize, height);
+  reference.resize(rows.size());
+  for (int y = 0; y < height; y++)
+  {
+    const std::vector<uint8_t>::const_iterator row = rows.begin() + (size_t)(height - 1 - y) * rowSize;
+    std::copy(row, row + rowSize, reference.begin() + (size_t)y * rowSize);
+  }
+  check("flipRows()", count, output, reference);
+}
+
+int main()
+{
+  std::mt19937 rng {42};
+
+  std::cout << "Checking the " << kdr::simd::getInstructionSet() << " pixel kernels against the scalar reference\n";
+
+  // Every count up to a few vectors wide covers each length of scalar tail
+  for (size_t count = 0; count <= MAX_TAIL_COUNT; count++)
+  {
+    checkKernels(count, rng);
+  }
+  checkKernels(LARGE_COUNT, rng);
+
+  if (mismatchCount > 0)
+  {
+    std::cerr << mismatchCount << " results differ from the scalar reference!\n";
+    return 1;
+  }
+  std::cout << "All results match the scalar reference\n";
+  return 0;
+}
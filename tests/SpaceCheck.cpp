@@ -0,0 +1,101 @@
+#include <string.h>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Kedarium/Simd.hpp"
+#include "Kedarium/Space.hpp"
+
+// Settings
+constexpr int    MATRIX_COUNT    {10000};
+constexpr size_t MAX_TAIL_COUNT  {40};
+// Above BATCH_PARALLEL_THRESHOLD and odd, so the threaded split and the scalar tail both run
+constexpr size_t LARGE_COUNT     {kdr::space::BATCH_PARALLEL_THRESHOLD * 2 + 13};
+
+int mismatchCount {0};
+
+/**
+ * Compares a kernel result with the scalar reference bit for bit.
+ */
+template <typename T>
+void check(const char* name, const T& result, const T& reference)
+{
+  if (memcmp(&result, &reference, sizeof(T)) == 0) return;
+  if (mismatchCount++ < 10)
+  {
+    std::cerr << "MISMATCH in " << name << " with the scalar reference!\n";
+  }
+}
+
+/**
+ * Checks a batched transform against scalar::transform over the first count elements.
+ */
+void checkBatch(const char* name, const kdr::space::Mat4& mat, const float w, const size_t count, std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> value {-100.f, 100.f};
+  std::vector<float> xs(count), ys(count), zs(count);
+  std::vector<float> outXs(count), outYs(count), outZs(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    xs[i] = value(rng);
+    ys[i] = value(rng);
+    zs[i] = value(rng);
+  }
+
+  if (w == 1.f) kdr::space::transformPoints(mat, xs.data(), ys.data(), zs.data(), outXs.data(), outYs.data(), outZs.data(), count);
+  else kdr::space::transformDirections(mat, xs.data(), ys.data(), zs.data(), outXs.data(), outYs.data(), outZs.data(), count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const kdr::space::Vec4 reference = kdr::space::scalar::transform(mat, {xs[i], ys[i], zs[i], w});
+    check(name, outXs[i], reference.x);
+    check(name, outYs[i], reference.y);
+    check(name, outZs[i], reference.z);
+  }
+}
+
+int main()
+{
+  std::mt19937 rng {42};
+  std::uniform_real_distribution<float> value {-100.f, 100.f};
+  const auto randomMat = [&]() {
+    kdr::space::Mat4 mat;
+    for (int i = 0; i < 4; i++)
+    {
+      for (int j = 0; j < 4; j++) mat[i][j] = value(rng);
+    }
+    return mat;
+  };
+
+  std::cout << "Checking the " << kdr::simd::getInstructionSet() << " kernels against the scalar reference\n";
+
+  for (int i = 0; i < MATRIX_COUNT; i++)
+  {
+    const kdr::space::Mat4 matA = randomMat();
+    const kdr::space::Mat4 matB = randomMat();
+    const kdr::space::Vec4 vec {value(rng), value(rng), value(rng), value(rng)};
+    const kdr::space::Vec3 offset {value(rng), value(rng), value(rng)};
+    check("multiply()", kdr::space::simd::multiply(matA, matB), kdr::space::scalar::multiply(matA, matB));
+    check("transform()", kdr::space::simd::transform(matA, vec), kdr::space::scalar::transform(matA, vec));
+    check("translate()", kdr::space::simd::translate(matA, offset), kdr::space::scalar::translate(matA, offset));
+  }
+
+  // Every count up to a few vectors wide covers each length of scalar tail
+  for (size_t count = 0; count <= MAX_TAIL_COUNT; count++)
+  {
+    const kdr::space::Mat4 mat = randomMat();
+    checkBatch("transformPoints()", mat, 1.f, count, rng);
+    checkBatch("transformDirections()", mat, 0.f, count, rng);
+  }
+  const kdr::space::Mat4 mat = randomMat();
+  checkBatch("transformPoints()", mat, 1.f, LARGE_COUNT, rng);
+  checkBatch("transformDirections()", mat, 0.f, LARGE_COUNT, rng);
+
+  if (mismatchCount > 0)
+  {
+    std::cerr << mismatchCount << " results differ from the scalar reference!\n";
+    return 1;
+  }
+  std::cout << "All results match the scalar reference\n";
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include "Kedarium/Space.hpp"
+
+// Compile-time checks of the constexpr math layer: this file only builds if
+// every expression below folds to a constant.
+static constexpr bool isNear(const float a, const float b)
+{ return (a > b ? a - b : b - a) < 1e-5f; }
+
+static_assert(kdr::space::radians(180.f) == kdr::space::PI, "radians() must fold to a constant");
+static_assert(isNear(kdr::space::sin(kdr::space::PI / 6.f), 0.5f), "sin() must fold to a constant");
+static_assert(isNear(kdr::space::cos(kdr::space::PI / 3.f), 0.5f), "cos() must fold to a constant");
+static_assert(isNear(kdr::space::tan(kdr::space::PI / 4.f), 1.f), "tan() must fold to a constant");
+static_assert(kdr::space::sqrt(16.f) == 4.f, "sqrt() must fold to a constant");
+static_assert(kdr::space::length(kdr::space::Vec3 {2.f, 3.f, 6.f}) == 7.f, "length() must fold to a constant");
+static_assert(
+  kdr::space::cross(kdr::space::Vec3 {1.f, 0.f, 0.f}, kdr::space::Vec3 {0.f, 1.f, 0.f}) == kdr::space::Vec3 {0.f, 0.f, 1.f},
+  "cross() must fold to a constant"
+);
+static_assert(
+  kdr::space::Mat4 {2.f} * kdr::space::Mat4 {3.f} == kdr::space::Mat4 {6.f},
+  "Mat4 multiplication must fold to a constant"
+);
+static_assert(
+  kdr::space::Mat4 {2.f} * kdr::space::Vec4 {1.f, 2.f, 3.f, 4.f} == kdr::space::Vec4 {2.f, 4.f, 6.f, 8.f},
+  "Mat4 * Vec4 must fold to a constant"
+);
+static_assert(
+  kdr::space::translate(kdr::space::Mat4 {1.f}, {1.f, 2.f, 3.f}) * kdr::space::Vec4 {0.f, 0.f, 0.f, 1.f} == kdr::space::Vec4 {1.f, 2.f, 3.f, 1.f},
+  "translate() must fold to a constant"
+);
+static_assert(isNear(kdr::space::perspective(90.f, 1.f, 1.f, 3.f)[1][1], 1.f), "perspective() must fold to a constant");
+static_assert(kdr::space::perspective(90.f, 1.f, 1.f, 3.f)[3][2] == -3.f, "perspective() must fold to a constant");
+static_assert(kdr::space::ortho(-2.f, 2.f, -1.f, 1.f, 0.f, 1.f)[0][0] == 0.5f, "ortho() must fold to a constant");
+static_assert(kdr::space::ortho(-2.f, 2.f, -1.f, 1.f, 0.f, 1.f)[3][2] == -1.f, "ortho() must fold to a constant");
+static_assert(
+  kdr::space::lookAt({0.f, 0.f, 5.f}, {0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}) == kdr::space::translate(kdr::space::Mat4 {1.f}, {0.f, 0.f, -5.f}),
+  "lookAt() must fold to a constant"
+);
+static_assert(
+  isNear(kdr::space::rotate(kdr::space::angleAxis(90.f, {0.f, 0.f, 1.f}), {1.f, 0.f, 0.f}).y, 1.f),
+  "Quat rotation must fold to a constant"
+);
+static_assert(
+  isNear((kdr::space::toMat3(kdr::space::angleAxis(90.f, {0.f, 0.f, 1.f})) * kdr::space::Vec3 {1.f, 0.f, 0.f}).y, 1.f),
+  "toMat3() must fold to a constant"
+);
+
+int main()
+{
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include <string.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Kedarium/Pack.hpp"
+
+void printUsage()
+{
+  std::cerr << "Usage: asset-packer <output.kpak> <directory|file>... [--compress]\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  bool                     isCompressed {false};
+  std::vector<std::string> filePaths;
+  for (int i = 2; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--compress") == 0)
+    {
+      isCompressed = true;
+      continue;
+    }
+    if (argv[i][0] == '-')
+    {
+      printUsage();
+      return 1;
+    }
+
+    // Entries are named by their path as given, e.g. "resources/Textures/concrete.png"
+    std::error_code error;
+    if (std::filesystem::is_directory(argv[i], error))
+    {
+      for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(argv[i], error))
+      {
+        if (entry.is_regular_file()) filePaths.push_back(entry.path().generic_string());
+      }
+    }
+    else if (std::filesystem::is_regular_file(argv[i], error))
+    {
+      filePaths.push_back(argv[i]);
+    }
+    if (error)
+    {
+      std::cerr << "Failed to read path (" << argv[i] << ")!\n";
+      return 1;
+    }
+  }
+
+  if (!kdr::file::writePack(argv[1], filePaths, isCompressed))
+  {
+    return 1;
+  }
+  std::cout << "Packed " << filePaths.size() << " files into " << argv[1] << '\n';
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <string.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "Kedarium/Image.hpp"
+#include "Kedarium/ImageFormat.hpp"
+
+const char* getChannelName(const int channels)
+{
+  static const char* NAMES[5] {"empty", "gray", "gray-alpha", "RGB", "RGBA"};
+  return NAMES[channels];
+}
+
+void printUsage()
+{
+  std::cerr << "Usage: image-converter <input.png|input.qoi|input.raw> <output.qoi|output.raw> [--rgba]\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  bool isRGBA {false};
+  for (int i = 3; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--rgba") == 0) isRGBA = true;
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const std::string extension = std::filesystem::path(argv[2]).extension().string();
+  if (extension != ".qoi" && extension != ".raw")
+  {
+    std::cerr << "Unknown output format (" << argv[2] << ")!\n";
+    printUsage();
+    return 1;
+  }
+
+  kdr::img::Image image;
+  if (!kdr::img::loadImage(argv[1], image, isRGBA))
+  {
+    return 1;
+  }
+  const bool isSaved = extension == ".qoi" ?
+    kdr::img::saveQOI(argv[2], image) :
+    kdr::img::saveRawImage(argv[2], image);
+  if (!isSaved)
+  {
+    return 1;
+  }
+
+  // QOI only stores RGB and RGBA
+  const int channels = extension == ".qoi" ? (image.getChannels() % 2 == 0 ? 4 : 3) : image.getChannels();
+  std::error_code error;
+  std::cout << "Converted " << argv[1] << " (" << std::filesystem::file_size(argv[1], error) << " bytes, ";
+  std::cout << getChannelName(image.getChannels()) << ") to " << argv[2] << " (";
+  std::cout << std::filesystem::file_size(argv[2], error) << " bytes, " << getChannelName(channels) << ")\n";
+  return 0;
+}
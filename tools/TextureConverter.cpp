@@ -0,0 +1,116 @@
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Kedarium/Compression.hpp"
+#include "Kedarium/Image.hpp"
+#include "Kedarium/ImageFormat.hpp"
+#include "Kedarium/Mipmap.hpp"
+#include "Kedarium/Pixel.hpp"
+#include "Kedarium/TextureFile.hpp"
+
+void printUsage()
+{
+  std::cerr << "Usage: texture-converter <input.png|input.qoi|input.raw> <output.kdt> [rgba8|bc1|bc3|bc7] [--srgb] [--no-mips] [--box] [--premultiply]\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  std::string format          {"bc7"};
+  bool        isSRGB          {false};
+  bool        hasMips         {true};
+  bool        isBox           {false};
+  bool        isPremultiplied {false};
+  for (int i = 3; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--srgb") == 0) isSRGB = true;
+    else if (strcmp(argv[i], "--no-mips") == 0) hasMips = false;
+    else if (strcmp(argv[i], "--box") == 0) isBox = true;
+    else if (strcmp(argv[i], "--premultiply") == 0) isPremultiplied = true;
+    else if (argv[i][0] != '-') format = argv[i];
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  kdr::img::TextureFile textureFile;
+  if (format == "rgba8") textureFile.format = isSRGB ? kdr::img::PixelFormat::SRGB8_ALPHA8 : kdr::img::PixelFormat::RGBA8;
+  else if (format == "bc1") textureFile.format = isSRGB ? kdr::img::PixelFormat::BC1_SRGB : kdr::img::PixelFormat::BC1;
+  else if (format == "bc3") textureFile.format = isSRGB ? kdr::img::PixelFormat::BC3_SRGB : kdr::img::PixelFormat::BC3;
+  else if (format == "bc7") textureFile.format = isSRGB ? kdr::img::PixelFormat::BC7_SRGB : kdr::img::PixelFormat::BC7;
+  else
+  {
+    std::cerr << "Unknown format (" << format << ")!\n";
+    printUsage();
+    return 1;
+  }
+
+  kdr::img::Image image;
+  if (!kdr::img::loadImage(argv[1], image, true))
+  {
+    return 1;
+  }
+  int width  = image.getWidth();
+  int height = image.getHeight();
+  // Before the mips, so transparent texels do not bleed into their neighbors
+  if (isPremultiplied)
+  {
+    kdr::img::premultiplyAlpha(image.getData(), image.getData(), image.getSize() / 4);
+  }
+
+  std::vector<std::vector<uint8_t>> mips;
+  if (hasMips)
+  {
+    const kdr::img::MipFilter filter = isBox ? kdr::img::MipFilter::Box : kdr::img::MipFilter::Kaiser;
+    kdr::img::generateMipChain(image.getData(), width, height, filter, isSRGB, mips);
+  }
+  else
+  {
+    mips.emplace_back(image.getData(), image.getData() + image.getSize());
+  }
+
+  textureFile.width  = width;
+  textureFile.height = height;
+  for (const std::vector<uint8_t>& mip : mips)
+  {
+    textureFile.levels.emplace_back();
+    std::vector<uint8_t>& level = textureFile.levels.back();
+    switch (textureFile.format)
+    {
+      case kdr::img::PixelFormat::BC1:
+      case kdr::img::PixelFormat::BC1_SRGB:
+        kdr::img::encodeBC1(mip.data(), width, height, level);
+        break;
+      case kdr::img::PixelFormat::BC3:
+      case kdr::img::PixelFormat::BC3_SRGB:
+        kdr::img::encodeBC3(mip.data(), width, height, level);
+        break;
+      case kdr::img::PixelFormat::BC7:
+      case kdr::img::PixelFormat::BC7_SRGB:
+        kdr::img::encodeBC7(mip.data(), width, height, level);
+        break;
+      default:
+        level = mip;
+        break;
+    }
+
+    width  = width  > 1 ? width  / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+
+  if (!kdr::img::saveTextureFile(argv[2], textureFile))
+  {
+    return 1;
+  }
+  std::cout << "Wrote " << argv[2] << " (" << format << ", " << textureFile.levels.size() << " levels)\n";
+  return 0;
+}